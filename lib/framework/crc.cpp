@@ -735,6 +735,30 @@ bool SessionKeys::decryptMessageFromOther(void const *data, size_t dataLen, std:
 
 typedef uint32_t crc_t;
 
+// Hardware CRC-32 support: PCLMULQDQ is detected at runtime on x86, the ARMv8 CRC32 extension at compile time
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || (defined(_M_IX86) && !defined(_M_ARM64EC))) && (defined(__GNUC__) || defined(__clang__) || defined(WZ_CC_MSVC))
+#  define WZ_CRC_HAVE_PCLMUL 1
+#  if defined(WZ_CC_MSVC)
+#    include <intrin.h>
+#    define WZ_CRC_TARGET_PCLMUL
+#  else
+#    define WZ_CRC_TARGET_PCLMUL __attribute__((target("sse4.1,pclmul")))
+#  endif
+#  include <emmintrin.h>
+#  include <smmintrin.h>
+#  include <wmmintrin.h>
+#else
+#  define WZ_CRC_HAVE_PCLMUL 0
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#  define WZ_CRC_HAVE_ARMV8 1
+#  include <arm_acle.h>
+#else
+#  define WZ_CRC_HAVE_ARMV8 0
+#endif
+
 /**
  * crc-32 model
  * using the configuration:
@@ -1038,7 +1062,7 @@ uint32_t crc_init()
 #  pragma GCC diagnostic ignored "-Wcast-align"
 #endif
 
-crc_t crc_update(crc_t crc, const void *data, size_t data_len)
+static crc_t crc_update_slice8(crc_t crc, const void *data, size_t data_len)
 {
 	const unsigned char *d = (const unsigned char *)data;
 	unsigned int tbl_idx;
@@ -1099,4 +1123,192 @@ crc_t crc_update(crc_t crc, const void *data, size_t data_len)
 #  pragma GCC diagnostic pop
 #endif
 
+// Hardware accelerated versions of crc_update_slice8, which must give bit-exact results.
+
+#if WZ_CRC_HAVE_PCLMUL
+
+/**
+ * Folding with carry-less multiplication, as described in Intel's "Fast CRC Computation for Generic
+ * Polynomials Using PCLMULQDQ Instruction" (the bit-reflected domain constants are given at its end).
+ * Requires data_len >= 64, and data_len a multiple of 16.
+ */
+WZ_CRC_TARGET_PCLMUL static crc_t crc_fold_pclmul(crc_t crc, const unsigned char *buf, size_t data_len)
+{
+	alignas(16) static const uint64_t k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+	alignas(16) static const uint64_t k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+	alignas(16) static const uint64_t k5k0[] = { 0x0163cd6124, 0x0000000000 };
+	alignas(16) static const uint64_t poly[] = { 0x01db710641, 0x01f7011641 };
+
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+	x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+	x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+	x0 = _mm_load_si128((const __m128i *)k1k2);
+	buf += 64;
+	data_len -= 64;
+
+	// Fold 4 x 128 bits in parallel
+	while (data_len >= 64)
+	{
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		y5 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+		y6 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+		y7 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+		y8 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+		buf += 64;
+		data_len -= 64;
+	}
+
+	// Fold into 128 bits
+	x0 = _mm_load_si128((const __m128i *)k3k4);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	// Fold the remaining 128 bit blocks
+	while (data_len >= 16)
+	{
+		x2 = _mm_loadu_si128((const __m128i *)buf);
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+		buf += 16;
+		data_len -= 16;
+	}
+
+	// Fold 128 bits to 64 bits
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_srli_si128(x1, 8);
+	x1 = _mm_xor_si128(x1, x2);
+
+	x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduction to 32 bits
+	x0 = _mm_load_si128((const __m128i *)poly);
+
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return static_cast<crc_t>(_mm_extract_epi32(x1, 1));
+}
+
+static crc_t crc_update_pclmul(crc_t crc, const void *data, size_t data_len)
+{
+	if (data_len < 64)
+	{
+		return crc_update_slice8(crc, data, data_len);
+	}
+	const unsigned char *d = (const unsigned char *)data;
+	const size_t foldLen = data_len & ~static_cast<size_t>(15);
+	crc = crc_fold_pclmul(crc, d, foldLen);
+	return crc_update_slice8(crc, d + foldLen, data_len - foldLen);
+}
+
+static bool crc_cpu_has_pclmul()
+{
+#  if defined(WZ_CC_MSVC)
+	int cpuInfo[4] = {0, 0, 0, 0};
+	__cpuid(cpuInfo, 1);
+	const bool hasPCLMULQDQ = (cpuInfo[2] & (1 << 1)) != 0;
+	const bool hasSSE41 = (cpuInfo[2] & (1 << 19)) != 0;
+	return hasPCLMULQDQ && hasSSE41;
+#  else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#  endif
+}
+
+#endif // WZ_CRC_HAVE_PCLMUL
+
+#if WZ_CRC_HAVE_ARMV8
+
+static crc_t crc_update_armv8(crc_t crc, const void *data, size_t data_len)
+{
+	const unsigned char *d = (const unsigned char *)data;
+
+	while (data_len && (((uintptr_t)(const void *)d) % 8 != 0))
+	{
+		crc = __crc32b(crc, *d++);
+		data_len--;
+	}
+	while (data_len >= 8)
+	{
+		uint64_t value;
+		memcpy(&value, d, sizeof(value));
+		crc = __crc32d(crc, value);
+		d += 8;
+		data_len -= 8;
+	}
+	while (data_len--)
+	{
+		crc = __crc32b(crc, *d++);
+	}
+	return crc;
+}
+
+#endif // WZ_CRC_HAVE_ARMV8
+
+typedef crc_t (*crc_update_func)(crc_t crc, const void *data, size_t data_len);
+
+static crc_update_func crc_select_impl()
+{
+#if WZ_CRC_HAVE_ARMV8
+	debug(LOG_WZ, "Using ARMv8 CRC32 instructions");
+	return crc_update_armv8;
+#else
+#  if WZ_CRC_HAVE_PCLMUL
+	if (crc_cpu_has_pclmul())
+	{
+		debug(LOG_WZ, "Using PCLMULQDQ CRC32");
+		return crc_update_pclmul;
+	}
+#  endif
+	return crc_update_slice8;
+#endif
+}
+
+crc_t crc_update(crc_t crc, const void *data, size_t data_len)
+{
+	static const crc_update_func impl = crc_select_impl();
+	return impl(crc, data, data_len);
+}
+
 }
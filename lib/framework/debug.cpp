@@ -32,8 +32,12 @@
 #include <time.h>
 #include "string_ext.h"
 #include "wzapp.h"
-#include <map>
 #include <string>
+#include <unordered_set>
+#include <vector>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
 // On Fedora 40, GCC 14 produces false-positive warnings for -Walloc-zero
 // when compiling <regex> with optimizations. Silence these warnings.
 #if !defined(__clang__) && !defined(__INTEL_COMPILER) && defined(__GNUC__) && __GNUC__ >= 14 && defined(__OPTIMIZE__)
@@ -128,9 +132,211 @@ static const char *code_part_names[] =
 static bool useInputBuffer1 = false;
 static bool debug_flush_stderr = false;
 
-static std::map<std::string, int> warning_list;	// only used for LOG_WARNING
+static std::unordered_set<uint64_t> warning_list;	// only used for LOG_WARNING, hashes of warnings that were already printed
 static std::mutex warning_list_mutex;
 
+/// Lines waiting to be handed to the deferred (I/O) callbacks by the writer thread
+struct DeferredOutputLine
+{
+	code_part part;
+	char text[MAX_LEN_LOG_LINE];
+};
+
+struct DeferredOutputState
+{
+	static const size_t capacity = 1024;
+	std::unique_ptr<DeferredOutputLine[]> lines; ///< Ring buffer of capacity lines
+	size_t head = 0; ///< Total lines queued, protected by mutex
+	size_t tail = 0; ///< Total lines written, protected by mutex
+	unsigned dropped = 0; ///< Lines dropped because the buffer was full, protected by mutex
+	bool stop = false; ///< Protected by mutex
+	std::vector<debug_callback *> callbacks; ///< The deferred callbacks, protected by mutex (the writer must not walk callbackRegistry)
+	bool callbacksChanged = false; ///< Protected by mutex
+	std::atomic<bool> running{false}; ///< Only changed by the thread that registers callbacks / shuts down
+	std::mutex mutex;
+	std::condition_variable queued;
+	std::condition_variable written;
+	std::thread thread;
+};
+static DeferredOutputState &deferredOutput = *new DeferredOutputState();  // Intentionally never destroyed, may be used by atexit handlers.
+
+static void callDeferredCallbacks(const char *str, code_part part)
+{
+	for (debug_callback *curCallback = callbackRegistry; curCallback != nullptr; curCallback = curCallback->next)
+	{
+		if (curCallback->deferred)
+		{
+			curCallback->callback(&curCallback->data, str, part);
+		}
+	}
+}
+
+static void deferredOutputWriter()
+{
+	std::vector<debug_callback *> callbacks; // snapshot of deferredOutput.callbacks
+	auto writeLine = [&callbacks](const char *str, code_part part) {
+		for (debug_callback *curCallback : callbacks)
+		{
+			curCallback->callback(&curCallback->data, str, part);
+		}
+	};
+
+	std::unique_lock<std::mutex> lock(deferredOutput.mutex);
+	while (true)
+	{
+		deferredOutput.queued.wait(lock, [] { return deferredOutput.stop || deferredOutput.head != deferredOutput.tail || deferredOutput.dropped > 0; });
+		const size_t begin = deferredOutput.tail;
+		const size_t end = deferredOutput.head;
+		const unsigned dropped = deferredOutput.dropped;
+		deferredOutput.dropped = 0;
+		if (begin == end && dropped == 0 && deferredOutput.stop)
+		{
+			break;
+		}
+		if (deferredOutput.callbacksChanged)
+		{
+			callbacks = deferredOutput.callbacks;
+			deferredOutput.callbacksChanged = false;
+		}
+		lock.unlock();
+
+		// Producers never touch slots in [tail, head), so these can be written without holding the lock
+		for (size_t i = begin; i != end; ++i)
+		{
+			const DeferredOutputLine &line = deferredOutput.lines[i % DeferredOutputState::capacity];
+			writeLine(line.text, line.part);
+		}
+		if (dropped > 0)
+		{
+			char droppedMessage[128];
+			ssprintf(droppedMessage, "%-8s|log writer fell behind, %u lines dropped", code_part_names[LOG_WARNING], dropped);
+			writeLine(droppedMessage, LOG_WARNING);
+		}
+
+		lock.lock();
+		deferredOutput.tail = end;
+		deferredOutput.written.notify_all();
+	}
+}
+
+/// Returns false if the writer is stopping (and may already have exited), in which case the caller must write the line itself
+static bool queueDeferredOutput(const char *str, code_part part)
+{
+	{
+		std::lock_guard<std::mutex> guard(deferredOutput.mutex);
+		if (deferredOutput.stop)
+		{
+			return false;
+		}
+		if (deferredOutput.head - deferredOutput.tail >= DeferredOutputState::capacity)
+		{
+			++deferredOutput.dropped;
+			return true;
+		}
+		DeferredOutputLine &line = deferredOutput.lines[deferredOutput.head % DeferredOutputState::capacity];
+		line.part = part;
+		sstrcpy(line.text, str);
+		++deferredOutput.head;
+	}
+	deferredOutput.queued.notify_one();
+	return true;
+}
+
+void debugFlushDeferredOutput()
+{
+	if (!deferredOutput.running || deferredOutput.thread.get_id() == std::this_thread::get_id())
+	{
+		return;
+	}
+	std::unique_lock<std::mutex> lock(deferredOutput.mutex);
+	const size_t target = deferredOutput.head;
+	// once stopping, the thread that stops the writer waits for everything to be written instead
+	deferredOutput.written.wait(lock, [target] { return deferredOutput.tail >= target || deferredOutput.stop; });
+}
+
+static void stopDeferredOutputWriter()
+{
+	if (!deferredOutput.running)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(deferredOutput.mutex);
+		deferredOutput.stop = true;
+	}
+	deferredOutput.queued.notify_one();
+	deferredOutput.written.notify_all();
+	deferredOutput.thread.join();
+	deferredOutput.running = false;
+	std::lock_guard<std::mutex> guard(deferredOutput.mutex);
+	deferredOutput.stop = false;
+}
+
+static void startDeferredOutputWriter()
+{
+	if (deferredOutput.running)
+	{
+		return;
+	}
+	if (!deferredOutput.lines)
+	{
+		deferredOutput.lines.reset(new DeferredOutputLine[DeferredOutputState::capacity]);
+		// Don't lose queued lines (or leave a joinable thread behind) if we exit without going through debug_exit()
+		atexit(stopDeferredOutputWriter);
+	}
+	deferredOutput.thread = std::thread(deferredOutputWriter);
+	deferredOutput.running = true;
+}
+
+void debugPauseDeferredOutput(bool pause)
+{
+	if (pause)
+	{
+		stopDeferredOutputWriter();
+		return;
+	}
+	bool anyDeferred = false;
+	{
+		std::lock_guard<std::mutex> guard(deferredOutput.mutex);
+		anyDeferred = !deferredOutput.callbacks.empty();
+	}
+	if (anyDeferred)
+	{
+		startDeferredOutputWriter();
+	}
+}
+
+/// Cheap, collision-resistant enough key for de-duplicating warnings without keeping their text around
+static uint64_t warningHash(const char *function, const char *text)
+{
+	uint64_t hash = 14695981039346656037ULL; // FNV-1a
+	for (const char *str : {function, "-", text})
+	{
+		for (; *str != '\0'; ++str)
+		{
+			hash = (hash ^ static_cast<unsigned char>(*str)) * 1099511628211ULL;
+		}
+	}
+	return hash;
+}
+
+/// "HH:MM:SS" for the current time, only re-formatted when the second changes
+static const char *debugTimeString()
+{
+	thread_local time_t cachedTime = 0;
+	thread_local char cachedString[15] = {'\0'};
+
+	time_t rawtime;
+	time(&rawtime);
+	if (rawtime != cachedTime || cachedString[0] == '\0')
+	{
+		struct tm timeinfo = getLocalTime(rawtime, true);
+		strftime(cachedString, sizeof(cachedString), "%H:%M:%S", &timeinfo);
+		cachedTime = rawtime;
+	}
+	return cachedString;
+}
+
 /**
  * Convert code_part names to enum. Case insensitive.
  *
@@ -207,6 +413,10 @@ void debug_callback_win32debug(WZ_DECL_UNUSED void **data, const char *outputBuf
 void debug_callback_file(void **data, const char *outputBuffer, code_part)
 {
 	FILE *logfile = (FILE *)*data;
+	if (logfile == nullptr)
+	{
+		return; // could not be reopened, see debugReopenLogFiles()
+	}
 
 	if (!strchr(outputBuffer, '\n'))
 	{
@@ -304,7 +514,10 @@ bool debug_callback_file_init(void **data)
 void debug_callback_file_exit(void **data)
 {
 	FILE *logfile = (FILE *)*data;
-	fclose(logfile);
+	if (logfile != nullptr)
+	{
+		fclose(logfile);
+	}
 	*data = nullptr;
 }
 
@@ -373,8 +586,40 @@ void debug_init()
 }
 
 
+void debugReopenLogFiles(const char *suffix)
+{
+	ASSERT_OR_RETURN(, !deferredOutput.running, "Deferred output must be paused");
+	for (debug_callback *curCallback = callbackRegistry; curCallback != nullptr; curCallback = curCallback->next)
+	{
+		if (curCallback->callback != debug_callback_file || curCallback->data == nullptr)
+		{
+			continue;
+		}
+		std::string fileName = WZDebugfilename.toUtf8();
+		const size_t extension = fileName.find_last_of('.');
+		const size_t separator = fileName.find_last_of("/\\");
+		if (extension != std::string::npos && (separator == std::string::npos || extension > separator))
+		{
+			fileName.insert(extension, suffix);
+		}
+		else
+		{
+			fileName += suffix;
+		}
+		debug_callback_file_exit(&curCallback->data);
+		WzString newFileName = WzString::fromUtf8(fileName);
+		curCallback->data = &newFileName;
+		if (!debug_callback_file_init(&curCallback->data))
+		{
+			curCallback->data = nullptr;
+		}
+	}
+}
+
 void debug_exit()
 {
+	stopDeferredOutputWriter();
+
 	debug_callback *curCallback = callbackRegistry, * tmpCallback = nullptr;
 
 	while (curCallback)
@@ -391,11 +636,16 @@ void debug_exit()
 		std::lock_guard<std::mutex> guard(warning_list_mutex);
 		warning_list.clear();
 	}
+	{
+		std::lock_guard<std::mutex> guard(deferredOutput.mutex);
+		deferredOutput.callbacks.clear();
+		deferredOutput.callbacksChanged = true;
+	}
 	callbackRegistry = nullptr;
 }
 
 
-void debug_register_callback(debug_callback_fn callback, debug_callback_init init, debug_callback_exit exit, void *data)
+void debug_register_callback(debug_callback_fn callback, debug_callback_init init, debug_callback_exit exit, void *data, bool deferred)
 {
 	debug_callback *curCallback = callbackRegistry, * tmpCallback = nullptr;
 
@@ -406,6 +656,7 @@ void debug_register_callback(debug_callback_fn callback, debug_callback_init ini
 	tmpCallback->init = init;
 	tmpCallback->exit = exit;
 	tmpCallback->data = data;
+	tmpCallback->deferred = deferred;
 
 	if (tmpCallback->init
 	    && !tmpCallback->init(&tmpCallback->data))
@@ -415,6 +666,16 @@ void debug_register_callback(debug_callback_fn callback, debug_callback_init ini
 		return;
 	}
 
+	if (deferred)
+	{
+		{
+			std::lock_guard<std::mutex> guard(deferredOutput.mutex);
+			deferredOutput.callbacks.push_back(tmpCallback);
+			deferredOutput.callbacksChanged = true;
+		}
+		startDeferredOutputWriter();
+	}
+
 	if (!curCallback)
 	{
 		callbackRegistry = tmpCallback;
@@ -452,12 +713,32 @@ bool debug_enable_switch(const char *str)
 static void printToDebugCallbacks(const char *const str, code_part part)
 {
 	debug_callback *curCallback;
+	bool anyDeferred = false;
 
 	// Loop over all callbacks, invoking them with the given data string
 	for (curCallback = callbackRegistry; curCallback != nullptr; curCallback = curCallback->next)
 	{
+		if (curCallback->deferred && deferredOutput.running)
+		{
+			anyDeferred = true;
+			continue;
+		}
 		curCallback->callback(&curCallback->data, str, part);
 	}
+
+	if (anyDeferred)
+	{
+		if (!queueDeferredOutput(str, part))
+		{
+			callDeferredCallbacks(str, part);
+			return;
+		}
+		if (part == LOG_ERROR || part == LOG_FATAL)
+		{
+			// these may be the last thing we get to log
+			debugFlushDeferredOutput();
+		}
+	}
 }
 
 void _realObjTrace(int id, const char *function, const char *str, ...)
@@ -552,14 +833,7 @@ void _debugFromGfxCallback(int line, code_part part, const char *function, const
 	char outputBuffer[MAX_LEN_LOG_LINE];
 	char tmpRepeatBuffer[128] = {0};
 
-	time_t rawtime;
-	struct tm timeinfo = {};
-	char ourtime[15];		//HH:MM:SS
-	time(&rawtime);
-	timeinfo = getLocalTime(rawtime, true);
-	strftime(ourtime, 15, "%H:%M:%S", &timeinfo);
-
-	int numPrefixChars = ssprintf(outputBuffer, "%-8s|%s: [%s:%d] ", code_part_names[part], ourtime, function, line);
+	int numPrefixChars = ssprintf(outputBuffer, "%-8s|%s: [%s:%d] ", code_part_names[part], debugTimeString(), function, line);
 	if (numPrefixChars < 0)
 	{
 		// encoding error occurred...
@@ -658,7 +932,7 @@ void _debug(int line, code_part part, const char *function, const char *str, ...
 		bool addedNew = false;
 		{
 			std::lock_guard<std::mutex> guard(warning_list_mutex);
-			addedNew = warning_list.insert(std::pair<std::string, int>(std::string(function) + "-" + std::string(outputBuffer), line)).second;
+			addedNew = warning_list.insert(warningHash(function, outputBuffer)).second;
 		}
 		if (addedNew)
 		{
@@ -718,18 +992,10 @@ void _debug(int line, code_part part, const char *function, const char *str, ...
 
 	if (!repeated)
 	{
-		time_t rawtime;
-		struct tm timeinfo = {};
-		char ourtime[15];		//HH:MM:SS
-
-		time(&rawtime);
-		timeinfo = getLocalTime(rawtime, true);
-		strftime(ourtime, 15, "%H:%M:%S", &timeinfo);
-
 		auto& currInputBuffer = inputBuffer[useInputBuffer1 ? 1 : 0];
 
 		// Assemble the outputBuffer:
-		ssprintf(outputBuffer, "%-8s|%s: %s", code_part_names[part], ourtime, currInputBuffer.data());
+		ssprintf(outputBuffer, "%-8s|%s: %s", code_part_names[part], debugTimeString(), currInputBuffer.data());
 
 		printToDebugCallbacks(outputBuffer, part);
 
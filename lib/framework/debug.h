@@ -225,6 +225,7 @@ struct debug_callback
 	debug_callback_init init; /// Setup function
 	debug_callback_exit exit; /// Cleaning function
 	void *data;  /// Used to pass data to the above functions. Eg a filename or handle.
+	bool deferred; /// Called from the log writer thread instead of the thread that logged the line
 };
 
 /**
@@ -256,8 +257,28 @@ const char *debugLastError();
  * \param	init		Initializer function which does all setup for the callback (optional, may be NULL)
  * \param	exit		Cleanup function called when unregistering the callback (optional, may be NULL)
  * \param	data		Data to be passed to all three functions (optional, may be NULL)
+ * \param	deferred	Hand lines to a background writer thread instead of calling the callback on the logging thread.
+ * 					Use this for callbacks that do (slow) I/O. Lines are dropped (and counted) rather than blocking
+ * 					the caller if the writer falls behind. Errors and fatal messages are always flushed immediately.
  */
-void debug_register_callback(debug_callback_fn callback, debug_callback_init init, debug_callback_exit exit, void *data);
+void debug_register_callback(debug_callback_fn callback, debug_callback_init init, debug_callback_exit exit, void *data, bool deferred = false);
+
+/**
+ * Wait until all lines queued for deferred callbacks have been written.
+ */
+void debugFlushDeferredOutput();
+
+/**
+ * Stop the log writer thread (after writing all queued lines), or start it again.
+ * While paused, deferred callbacks are called on the logging thread. Pause before fork(), as threads don't survive it.
+ */
+void debugPauseDeferredOutput(bool pause);
+
+/**
+ * Reopen the log file of every debug_callback_file callback under a new name: the current name with
+ * suffix inserted before the extension. Only call while deferred output is paused (e.g. in a forked child).
+ */
+void debugReopenLogFiles(const char *suffix);
 
 void debug_callback_file(void **data, const char *outputBuffer, code_part part);
 bool debug_callback_file_init(void **data);
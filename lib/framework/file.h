@@ -32,6 +32,13 @@ WZ_DECL_NONNULL(1) PHYSFS_file *openSaveFile(const char *fileName);
 /** Load the file with name pointed to by pFileName into a memory buffer. */
 WZ_DECL_NONNULL(1) bool loadFile(const char *pFileName, char **ppFileData, UDWORD *pFileSize, bool hard_fail = true);
 
+/** Hand the already read contents of a file to the next loadFile() of that path on the calling thread.
+ *  Takes ownership of pFileData, which must have been allocated by loadFile(). */
+WZ_DECL_NONNULL(1, 2) void loadFileSetPrefetched(const char *pFileName, char *pFileData, UDWORD fileSize);
+
+/** Free prefetched file contents that were not picked up by loadFile(). */
+void loadFileClearPrefetched();
+
 /** Save the data in the buffer into the given file */
 WZ_DECL_NONNULL(1) bool saveFile(const char *pFileName, const char *pFileData, UDWORD fileSize);
 
@@ -36,6 +36,7 @@
 #include "file_ext.h"
 
 #include <limits>
+#include <string>
 
 /************************************************************************************
  *
@@ -309,8 +310,38 @@ bool saveFile(const char *pFileName, const char *pFileData, UDWORD fileSize)
 	return true;
 }
 
+// File contents read ahead of time (by the resource loader's worker threads), see loadFileSetPrefetched()
+static thread_local std::string prefetchedFileName;
+static thread_local char *prefetchedFileData = nullptr;
+static thread_local UDWORD prefetchedFileSize = 0;
+
+void loadFileSetPrefetched(const char *pFileName, char *pFileData, UDWORD fileSize)
+{
+	loadFileClearPrefetched();
+	prefetchedFileName = pFileName;
+	prefetchedFileData = pFileData;
+	prefetchedFileSize = fileSize;
+}
+
+void loadFileClearPrefetched()
+{
+	free(prefetchedFileData);
+	prefetchedFileData = nullptr;
+	prefetchedFileSize = 0;
+	prefetchedFileName.clear();
+}
+
 bool loadFile(const char *pFileName, char **ppFileData, UDWORD *pFileSize, bool hard_fail /*= true*/)
 {
+	if (prefetchedFileData != nullptr && prefetchedFileName == pFileName)
+	{
+		*ppFileData = prefetchedFileData;
+		*pFileSize = prefetchedFileSize;
+		prefetchedFileData = nullptr;
+		prefetchedFileSize = 0;
+		prefetchedFileName.clear();
+		return true;
+	}
 	return loadFile2(pFileName, ppFileData, pFileSize, true, hard_fail);
 }
 
@@ -31,12 +31,17 @@
 
 #include "file.h"
 #include "resly.h"
+#include "wzapp.h"
 
-#include <list>
 #include <algorithm>
+#include <list>
+#include <vector>
+#include <string>
+#include <atomic>
 
 // Local prototypes
 static std::list<RES_TYPE *> psResTypes;
+static std::unordered_map<UDWORD, RES_TYPE *> psResTypeIndex;	// psResTypes indexed by HashedType
 
 /* The initial resource directory and the current resource directory */
 char aResDir[PATH_MAX];
@@ -47,6 +52,39 @@ static SDWORD resBlockID;
 
 // prototypes
 static void ResetResourceFile();
+static bool resMakeFileName(const char *pFile, char *aFileName, size_t maxlen);
+static bool resLoadFileImpl(const char *pType, const char *pFile, const char *aFileName);
+
+/// Number of worker threads reading files ahead of the main thread in resLoad()
+#define RES_PREFETCH_THREADS	4
+/// Maximum number of files read but not yet processed by the main thread
+#define RES_PREFETCH_AHEAD		16
+
+struct RES_PREFETCHED
+{
+	char *pBuffer = nullptr;
+	UDWORD size = 0;
+};
+
+/// A file listed in a .wrf, queued by resLoadFile() while resLoad() parses
+struct RES_PENDING
+{
+	std::string type;
+	std::string file;
+	std::string fileName;	///< full path, including resource directory and locale
+	bool prefetch;			///< whether the type's loader reads the file with loadFile(), so it is worth reading ahead
+	wz::packaged_task<RES_PREFETCHED()> task;
+	wz::future<RES_PREFETCHED> result;
+};
+
+// true while resLoad() parses a .wrf: resLoadFile() then queues files instead of loading them
+static bool resDeferLoads = false;
+static std::vector<RES_PENDING> resPending;
+
+// prefetch worker state
+static std::atomic<size_t> resPrefetchNext(0);
+static std::atomic<bool> resPrefetchQuit(false);
+static WZ_SEMAPHORE *resPrefetchSlots = nullptr;
 
 // callback to resload screen.
 static RESLOAD_CALLBACK resLoadCallback = nullptr;
@@ -152,6 +190,7 @@ bool resInitialise()
 	ASSERT(psResTypes.empty(),
 	       "resInitialise: resource module hasn't been shut down??");
 	psResTypes.clear();
+	psResTypeIndex.clear();
 	resBlockID = 0;
 	resLoadCallback = nullptr;
 
@@ -184,6 +223,26 @@ void resSetBaseDir(const char *pResDir)
 	sstrcpy(aResDir, pResDir);
 }
 
+/** Reads queued files in .wrf order, staying at most RES_PREFETCH_AHEAD files ahead of the main thread. This runs in a separate thread. */
+static int resPrefetchThreadFunc(void *)
+{
+	while (true)
+	{
+		wzSemaphoreWait(resPrefetchSlots);
+		if (resPrefetchQuit.load())
+		{
+			break;
+		}
+		size_t index = resPrefetchNext.fetch_add(1);
+		if (index >= resPending.size())
+		{
+			break;
+		}
+		resPending[index].task();
+	}
+	return 0;
+}
+
 /* Parse the res file */
 bool resLoad(const char *pResFile, SDWORD blockID)
 {
@@ -206,17 +265,95 @@ bool resLoad(const char *pResFile, SDWORD blockID)
 		return false;
 	}
 
-	// and parse it
+	// and parse it, collecting the list of files to load
+	resPending.clear();
+	resDeferLoads = true;
 	res_set_extra(&input);
 	if (res_parse() != 0)
 	{
 		debug(LOG_FATAL, "Failed to parse %s", pResFile);
 		retval = false;
 	}
+	resDeferLoads = false;
 
 	res_lex_destroy();
 	PHYSFS_close(input.input.physfsfile);
 
+	if (!retval)
+	{
+		resPending.clear();
+		return false;
+	}
+
+	// Read the files on worker threads, while the main thread processes them in .wrf order
+	for (RES_PENDING &pending : resPending)
+	{
+		std::string fileName = pending.fileName;
+		bool prefetch = pending.prefetch;
+		pending.task = wz::packaged_task<RES_PREFETCHED()>([fileName, prefetch]() {
+			RES_PREFETCHED prefetched;
+			if (prefetch && !loadFile(fileName.c_str(), &prefetched.pBuffer, &prefetched.size, false))
+			{
+				prefetched.pBuffer = nullptr;
+				prefetched.size = 0;
+			}
+			return prefetched;
+		});
+		pending.result = pending.task.get_future();
+	}
+
+	resPrefetchNext = 0;
+	resPrefetchQuit = false;
+	resPrefetchSlots = wzSemaphoreCreate(RES_PREFETCH_AHEAD);
+	WZ_THREAD *prefetchThreads[RES_PREFETCH_THREADS];
+	const size_t numThreads = std::min<size_t>(RES_PREFETCH_THREADS, resPending.size());
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		prefetchThreads[i] = wzThreadCreate(resPrefetchThreadFunc, nullptr, "wzResPrefetch");
+		wzThreadStart(prefetchThreads[i]);
+	}
+
+	size_t processed = 0;
+	for (; processed < resPending.size(); ++processed)
+	{
+		RES_PENDING &pending = resPending[processed];
+		RES_PREFETCHED prefetched = pending.result.get();
+		wzSemaphorePost(resPrefetchSlots);
+
+		if (prefetched.pBuffer != nullptr)
+		{
+			loadFileSetPrefetched(pending.fileName.c_str(), prefetched.pBuffer, prefetched.size);
+		}
+		bool success = resLoadFileImpl(pending.type.c_str(), pending.file.c_str(), pending.fileName.c_str());
+		loadFileClearPrefetched();
+
+		if (!success)
+		{
+			retval = false;
+			++processed;
+			break;
+		}
+	}
+
+	// Stop the workers, and free whatever they read that we did not get to
+	resPrefetchQuit = true;
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		wzSemaphorePost(resPrefetchSlots);
+	}
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		wzThreadJoin(prefetchThreads[i]);
+	}
+	size_t started = std::min<size_t>(resPrefetchNext.load(), resPending.size());
+	for (; processed < started; ++processed)
+	{
+		free(resPending[processed].result.get().pBuffer);
+	}
+	wzSemaphoreDestroy(resPrefetchSlots);
+	resPrefetchSlots = nullptr;
+	resPending.clear();
+
 	return retval;
 }
 
@@ -241,6 +378,59 @@ static RES_TYPE *resAlloc(const char *pType)
 }
 
 
+/* Find the RES_TYPE for a type string, or nullptr if there is none */
+static RES_TYPE *resFindType(const char *pType)
+{
+	auto it = psResTypeIndex.find(HashString(pType));
+	if (it == psResTypeIndex.end())
+	{
+		return nullptr;
+	}
+	ASSERT(strcmp(it->second->aType, pType) == 0, "Hash collision \"%s\" vs \"%s\"", it->second->aType, pType);
+	return it->second;
+}
+
+
+/* Add a RES_TYPE to the list of types, newer types shadowing older ones with the same name */
+static void resAddType(RES_TYPE *psT)
+{
+	psResTypes.emplace_front(psT);
+	psResTypeIndex[psT->HashedType] = psT;
+}
+
+
+/* Add a data item to the front of the list of items of its type */
+static void resAddData(RES_TYPE *psT, RES_DATA *psRes)
+{
+	ASSERT(psRes->pData != nullptr, "Resource %s has no data", psRes->aID);
+	psT->psRes.emplace_front(psRes);
+	// Lookups always found the most recently added item first, so the index points at that one
+	psT->resByHash[psRes->HashedID] = psRes;
+	psT->resByData.emplace(psRes->pData, psRes);
+}
+
+
+/* Remove a data item from the indices of its type (but not from the psRes list) */
+static void resRemoveDataIndex(RES_TYPE *psT, RES_DATA *psRes)
+{
+	// resLoadFileImpl() refuses duplicate IDs, so there is no older item to fall back to
+	auto hashIt = psT->resByHash.find(psRes->HashedID);
+	if (hashIt != psT->resByHash.end() && hashIt->second == psRes)
+	{
+		psT->resByHash.erase(hashIt);
+	}
+	auto dataRange = psT->resByData.equal_range(psRes->pData);
+	for (auto dataIt = dataRange.first; dataIt != dataRange.second; ++dataIt)
+	{
+		if (dataIt->second == psRes)
+		{
+			psT->resByData.erase(dataIt);
+			break;
+		}
+	}
+}
+
+
 /* Add a buffer load function for a file type */
 bool resAddBufferLoad(const char *pType, RES_BUFFERLOAD buffLoad, RES_FREE release)
 {
@@ -249,23 +439,25 @@ bool resAddBufferLoad(const char *pType, RES_BUFFERLOAD buffLoad, RES_FREE relea
 	psT->buffLoad = buffLoad;
 	psT->fileLoad = nullptr;
 	psT->release = release;
+	psT->prefetch = buffLoad != nullptr;
 
-	psResTypes.emplace_front(psT);
+	resAddType(psT);
 
 	return true;
 }
 
 
 /* Add a file name load function for a file type */
-bool resAddFileLoad(const char *pType, RES_FILELOAD fileLoad, RES_FREE release)
+bool resAddFileLoad(const char *pType, RES_FILELOAD fileLoad, RES_FREE release, bool readsWithLoadFile)
 {
 	RES_TYPE	*psT = resAlloc(pType);
 
 	psT->buffLoad = nullptr;
 	psT->fileLoad = fileLoad;
 	psT->release = release;
+	psT->prefetch = fileLoad != nullptr && readsWithLoadFile;
 
-	psResTypes.emplace_front(psT);
+	resAddType(psT);
 
 	return true;
 }
@@ -349,7 +541,7 @@ static SDWORD FindEmptyResourceFile()
 
 
 // Get a resource data file ... either loads it or just returns a pointer
-static bool RetreiveResourceFile(char *ResourceName, RESOURCEFILE **NewResource)
+static bool RetreiveResourceFile(const char *ResourceName, RESOURCEFILE **NewResource)
 {
 	SDWORD ResID;
 	RESOURCEFILE *ResData;
@@ -459,59 +651,81 @@ static void makeLocaleFile(char *fileName, size_t maxlen)  // given string must
 }
 
 
+/*!
+ * Build the full path of a resource file in the current resource directory,
+ * preferring a translated version if there is one
+ * \param[out] aFileName must be at least PATH_MAX bytes large
+ */
+static bool resMakeFileName(const char *pFile, char *aFileName, size_t maxlen)
+{
+	if (strlen(aCurrResDir) + strlen(pFile) + 1 >= PATH_MAX)
+	{
+		debug(LOG_ERROR, "resLoadFile: Filename too long!! %s%s", aCurrResDir, pFile);
+		return false;
+	}
+	strlcpy(aFileName, aCurrResDir, maxlen);
+	strlcat(aFileName, pFile, maxlen);
+
+	makeLocaleFile(aFileName, maxlen);  // check for translated file
+	return true;
+}
+
+
 /*!
  * Call the load function (registered in data.c)
  * for this filetype
  */
 bool resLoadFile(const char *pType, const char *pFile)
 {
-	void		*pData = nullptr;
 	char		aFileName[PATH_MAX];
-	UDWORD HashedName, HashedType = HashString(pType);
 
-	// Find the resource-type
-	auto resTypeIt = std::find_if(psResTypes.begin(), psResTypes.end(), [pType, HashedType](const RES_TYPE* psT)
+	if (!resMakeFileName(pFile, aFileName, sizeof(aFileName)))
 	{
-		if (psT->HashedType == HashedType)
-		{
-			ASSERT(strcmp(psT->aType, pType) == 0, "Hash collision \"%s\" vs \"%s\"", psT->aType, pType);
-			return true;
-		}
 		return false;
-	});
+	}
 
-	if (resTypeIt == psResTypes.end())
+	if (resDeferLoads)
+	{
+		// resLoad() is parsing a .wrf, so just queue the file
+		const RES_TYPE *psT = resFindType(pType);
+		RES_PENDING pending;
+		pending.type = pType;
+		pending.file = pFile;
+		pending.fileName = aFileName;
+		pending.prefetch = psT != nullptr && psT->prefetch;
+		resPending.push_back(std::move(pending));
+		return true;
+	}
+
+	return resLoadFileImpl(pType, pFile, aFileName);
+}
+
+static bool resLoadFileImpl(const char *pType, const char *pFile, const char *aFileName)
+{
+	void		*pData = nullptr;
+	UDWORD HashedName;
+
+	// Find the resource-type
+	RES_TYPE *psT = resFindType(pType);
+	if (psT == nullptr)
 	{
 		debug(LOG_WZ, "resLoadFile: Unknown type: %s", pType);
 		return false;
 	}
-	RES_TYPE* psT = *resTypeIt;
 
 	// Check for duplicates
 	HashedName = HashStringIgnoreCase(pFile);
-	for (const RES_DATA* psRes : psT->psRes)
-	{
-		if (psRes->HashedID == HashedName)
-		{
-			ASSERT(strcasecmp(psRes->aID, pFile) == 0, "Hash collision \"%s\" vs \"%s\"", psRes->aID, pFile);
-			debug(LOG_WZ, "Duplicate file name: %s (hash %x) for type %s",
-			      pFile, HashedName, psT->aType);
-			// assume that they are actually both the same and silently fail
-			// lovely little hack to allow some files to be loaded from disk (believe it or not!).
-			return true;
-		}
-	}
-
-	// Create the file name
-	if (strlen(aCurrResDir) + strlen(pFile) + 1 >= PATH_MAX)
+	auto dupIt = psT->resByHash.find(HashedName);
+	if (dupIt != psT->resByHash.end())
 	{
-		debug(LOG_ERROR, "resLoadFile: Filename too long!! %s%s", aCurrResDir, pFile);
-		return false;
+		const RES_DATA *psRes = dupIt->second;
+		ASSERT(strcasecmp(psRes->aID, pFile) == 0, "Hash collision \"%s\" vs \"%s\"", psRes->aID, pFile);
+		debug(LOG_WZ, "Duplicate file name: %s (hash %x) for type %s",
+		      pFile, HashedName, psT->aType);
+		// assume that they are actually both the same and silently fail
+		// lovely little hack to allow some files to be loaded from disk (believe it or not!).
+		return true;
 	}
-	sstrcpy(aFileName, aCurrResDir);
-	sstrcat(aFileName, pFile);
-
-	makeLocaleFile(aFileName, sizeof(aFileName));  // check for translated file
 
 	SetLastResourceFilename(pFile); // Save the filename in case any routines need it
 
@@ -572,7 +786,7 @@ bool resLoadFile(const char *pType, const char *pFile)
 		}
 
 		// Add the resource to the list
-		psT->psRes.emplace_front(psRes);
+		resAddData(psT, psRes);
 	}
 	return true;
 }
@@ -581,33 +795,23 @@ bool resLoadFile(const char *pType, const char *pFile)
 void *resGetDataFromHash(const char *pType, UDWORD HashedID)
 {
 	// Find the correct type
-	UDWORD HashedType = HashString(pType);
-
-	auto resTypeIt = std::find_if(psResTypes.begin(), psResTypes.end(), [HashedType](const RES_TYPE* psT)
-	{
-		return psT->HashedType == HashedType;
-	});
-	ASSERT(resTypeIt != psResTypes.end(), "resGetDataFromHash: Unknown type: %s", pType);
-	if (resTypeIt == psResTypes.end())
+	RES_TYPE *psT = resFindType(pType);
+	ASSERT(psT != nullptr, "resGetDataFromHash: Unknown type: %s", pType);
+	if (psT == nullptr)
 	{
 		return nullptr;
 	}
-	RES_TYPE* psT = *resTypeIt;
-
-	auto res = std::find_if(psT->psRes.begin(), psT->psRes.end(), [HashedID](const RES_DATA* rd)
-	{
-		return rd->HashedID == HashedID;
-	});
 
-	ASSERT(res != psT->psRes.end(), "resGetDataFromHash: Unknown ID: %0x Type: %s", HashedID, pType);
-	if (res == psT->psRes.end())
+	auto res = psT->resByHash.find(HashedID);
+	ASSERT(res != psT->resByHash.end(), "resGetDataFromHash: Unknown ID: %0x Type: %s", HashedID, pType);
+	if (res == psT->resByHash.end())
 	{
 		return nullptr;
 	}
 
-	(*res)->usage += 1;
+	res->second->usage += 1;
 
-	return (*res)->pData;
+	return res->second->pData;
 }
 
 
@@ -623,95 +827,61 @@ void *resGetData(const char *pType, const char *pID)
 bool resGetHashfromData(const char *pType, const void *pData, UDWORD *pHash)
 {
 	// Find the correct type
-	UDWORD	HashedType = HashString(pType);
-
-	auto resTypeIt = std::find_if(psResTypes.begin(), psResTypes.end(), [HashedType](const RES_TYPE* psT)
-	{
-		return psT->HashedType == HashedType;
-	});
-	ASSERT_OR_RETURN(false, resTypeIt != psResTypes.end(), "Unknown type: %x", HashedType);
-	RES_TYPE* psT = *resTypeIt;
+	RES_TYPE *psT = resFindType(pType);
+	ASSERT_OR_RETURN(false, psT != nullptr, "Unknown type: %s", pType);
 
 	// Find the resource
-	auto res = std::find_if(psT->psRes.begin(), psT->psRes.end(), [pData](const RES_DATA* rd)
-	{
-		return rd->pData == pData;
-	});
-
-	if (res == psT->psRes.end())
+	auto res = psT->resByData.find(pData);
+	if (res == psT->resByData.end())
 	{
-		ASSERT(false, "resGetHashfromData:: couldn't find data for type %x\n", HashedType);
+		ASSERT(false, "resGetHashfromData:: couldn't find data for type %s\n", pType);
 		return false;
 	}
 
-	*pHash = (*res)->HashedID;
+	*pHash = res->second->HashedID;
 
 	return true;
 }
 
 const char *resGetNamefromData(const char *type, const void *data)
 {
-	UDWORD   HashedType;
-
 	if (type == nullptr || data == nullptr)
 	{
 		return "";
 	}
 
-	// Find the correct type
-	HashedType = HashString(type);
-
 	// Find the resource table for the given type
-	auto resTypeIt = std::find_if(psResTypes.begin(), psResTypes.end(), [HashedType](const RES_TYPE* psT)
+	RES_TYPE *psT = resFindType(type);
+	if (psT == nullptr)
 	{
-		return psT->HashedType == HashedType;
-	});
-	if (resTypeIt == psResTypes.end())
-	{
-		ASSERT(false, "resGetHashfromData: Unknown type: %x", HashedType);
+		ASSERT(false, "resGetHashfromData: Unknown type: %s", type);
 		return "";
 	}
-	RES_TYPE* psT = *resTypeIt;
 
 	// Find the resource in the resource table
-	auto res = std::find_if(psT->psRes.begin(), psT->psRes.end(), [data](const RES_DATA* rd)
-	{
-		return rd->pData == data;
-	});
-
-	if (res == psT->psRes.end())
+	auto res = psT->resByData.find(data);
+	if (res == psT->resByData.end())
 	{
-		ASSERT(false, "resGetHashfromData:: couldn't find data for type %x\n", HashedType);
+		ASSERT(false, "resGetHashfromData:: couldn't find data for type %s\n", type);
 		return "";
 	}
 
-	return (*res)->aID;
+	return res->second->aID;
 }
 
 /* Simply returns true if a resource is present */
 bool resPresent(const char *pType, const char *pID)
 {
 	// Find the correct type
-	UDWORD HashedType = HashString(pType);
-
-	auto resTypeIt = std::find_if(psResTypes.begin(), psResTypes.end(), [HashedType](const RES_TYPE* psT)
-	{
-		return psT->HashedType == HashedType;
-	});
+	RES_TYPE *psT = resFindType(pType);
 	/* Bow out if unrecognised type */
-	ASSERT(resTypeIt != psResTypes.end(), "resPresent: Unknown type");
-	if (resTypeIt == psResTypes.end())
+	ASSERT(psT != nullptr, "resPresent: Unknown type");
+	if (psT == nullptr)
 	{
 		return false;
 	}
-	RES_TYPE* psT = *resTypeIt;
 
-	UDWORD HashedID = HashStringIgnoreCase(pID);
-	auto res = std::find_if(psT->psRes.begin(), psT->psRes.end(), [HashedID](const RES_DATA* rd)
-	{
-		return rd->HashedID == HashedID;
-	});
-	return res != psT->psRes.end();
+	return psT->resByHash.count(HashStringIgnoreCase(pID)) != 0;
 }
 
 
@@ -726,6 +896,7 @@ void resReleaseAll()
 	}
 
 	psResTypes.clear();
+	psResTypeIndex.clear();
 }
 
 
@@ -748,6 +919,8 @@ void resReleaseAllData()
 			return IterationResult::CONTINUE_ITERATION;
 		});
 		psT->psRes.clear();
+		psT->resByHash.clear();
+		psT->resByData.clear();
 	}
 }
 
@@ -774,6 +947,7 @@ void resReleaseBlockData(SDWORD blockID)
 				psT->release(psRes->pData);
 			}
 
+			resRemoveDataIndex(psT, psRes);
 			psT->psRes.erase(resIt);
 			free(psRes);
 			return IterationResult::CONTINUE_ITERATION;
@@ -27,6 +27,7 @@
 #include "lib/framework/frame.h"
 
 #include <list>
+#include <unordered_map>
 
 /** Maximum number of characters in a resource type. */
 #define RESTYPE_MAXCHAR		20
@@ -69,9 +70,12 @@ struct RES_TYPE
 
 	// we must have a pointer to the data here so that we can do a resGetData();
 	std::list<RES_DATA*> psRes;		// Linked list of data items of this type
+	std::unordered_map<UDWORD, RES_DATA*> resByHash;			// psRes indexed by HashedID
+	std::unordered_multimap<const void*, RES_DATA*> resByData;	// psRes indexed by pData (except nullptr data)
 	UDWORD	HashedType;				// hashed version of the name of the id - // a null hashedtype indicates end of list
 
 	RES_FILELOAD	fileLoad;		// This isn't really used any more ?
+	bool prefetch;					// whether the file can be read ahead (the loader reads it with loadFile())
 };
 
 
@@ -106,8 +110,9 @@ void resReleaseAllData();
 /** Add a buffer load and release function for a file type. */
 WZ_DECL_NONNULL(1) bool resAddBufferLoad(const char *pType, RES_BUFFERLOAD buffLoad, RES_FREE release);
 
-/** Add a file name load and release function for a file type. */
-WZ_DECL_NONNULL(1) bool resAddFileLoad(const char *pType, RES_FILELOAD fileLoad, RES_FREE release);
+/** Add a file name load and release function for a file type.
+ * Set readsWithLoadFile if fileLoad reads the file through loadFile(), so that resLoad() can read it ahead. */
+WZ_DECL_NONNULL(1) bool resAddFileLoad(const char *pType, RES_FILELOAD fileLoad, RES_FREE release, bool readsWithLoadFile = false);
 
 /** Call the load function for a file. */
 WZ_DECL_NONNULL(1, 2) bool resLoadFile(const char *pType, const char *pFile);
@@ -38,7 +38,7 @@ enum class IterationResult
 ///
 /// Currently two callable signatures are supported:
 /// * `IterationResult(ObjectType*)`
-/// * `IterationResult(std::list<ObjectType*>::iterator)`
+/// * `IterationResult(std::list<ObjectType*, Alloc>::iterator)`
 ///
 /// The latter overload is convenient when one needs to erase from or
 /// insert into the list being iterated directly inside the handler's body,
@@ -65,23 +65,23 @@ struct LoopBodyHandlerCallStrategy
 	static constexpr bool handler_accepts_ptr = std::is_convertible<
 		Callable,
 		std::function<IterationResult(ObjectType*)>>::value;
-	template <typename ObjectType>
+	template <typename ListIterator>
 	static constexpr bool handler_accepts_iter = std::is_convertible<
 		Callable,
-		std::function<IterationResult(typename std::list<ObjectType*>::iterator)>>::value;
+		std::function<IterationResult(ListIterator)>>::value;
 
 	// `Invoke` overload for Callable taking a list iterator as the argument
-	template <typename ObjectType>
-	static std::enable_if_t<handler_accepts_iter<ObjectType>, IterationResult>
-		Invoke(Callable handler, typename std::list<ObjectType*>::iterator iter)
+	template <typename ObjectType, typename ListIterator>
+	static std::enable_if_t<handler_accepts_iter<ListIterator>, IterationResult>
+		Invoke(Callable handler, ListIterator iter)
 	{
 		return handler(iter);
 	}
 
 	// `Invoke` overload for Callable taking a pointer to `ObjectType` as the argument
-	template <typename ObjectType>
+	template <typename ObjectType, typename ListIterator>
 	static std::enable_if_t<handler_accepts_ptr<ObjectType>, IterationResult>
-		Invoke(Callable handler, typename std::list<ObjectType*>::iterator iter)
+		Invoke(Callable handler, ListIterator iter)
 	{
 		return handler(*iter);
 	}
@@ -90,14 +90,14 @@ struct LoopBodyHandlerCallStrategy
 // Common iteration helper for lists of game objects
 // with an ability to execute loop body handlers which can
 // possibly invalidate the any iterator in the range `[begin(), currentIterator]`.
-template <typename ObjectType, typename MaybeErasingLoopBodyHandler>
-void mutating_list_iterate(std::list<ObjectType*>& list, MaybeErasingLoopBodyHandler handler)
+template <typename ObjectType, typename Alloc, typename MaybeErasingLoopBodyHandler>
+void mutating_list_iterate(std::list<ObjectType*, Alloc>& list, MaybeErasingLoopBodyHandler handler)
 {
 	using HandlerCallStrategy = LoopBodyHandlerCallStrategy<MaybeErasingLoopBodyHandler>;
 
 	static_assert(
 		   HandlerCallStrategy::template handler_accepts_ptr<ObjectType>
-		|| HandlerCallStrategy::template handler_accepts_iter<ObjectType>,
+		|| HandlerCallStrategy::template handler_accepts_iter<typename std::list<ObjectType*, Alloc>::iterator>,
 		"Unsupported loop body handler signature: "
 		"should return IterationResult and take either an ObjectType* or an iterator");
 
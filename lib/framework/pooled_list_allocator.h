@@ -0,0 +1,137 @@
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2024  Warzone 2100 Project
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file pooled_list_allocator.h
+ * Allocator that carves single-element allocations (such as `std::list` nodes)
+ * out of contiguous pages, so that walking a list touches neighbouring memory
+ * instead of nodes scattered all over the heap.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// Stateless allocator for node-based containers of game objects.
+///
+/// Single-element allocations come from a free list backed by pages of
+/// `ElementsPerPage` slots, shared by all containers using the same node type.
+/// Freshly allocated nodes are therefore adjacent in memory, and freed nodes are
+/// recycled (most recently freed first) before a new page is touched. Pages are never
+/// returned to the system.
+///
+/// All instances compare equal, so containers using this allocator can be moved,
+/// swapped and spliced into each other exactly like ones using `std::allocator`.
+///
+/// Not thread-safe: only use it for containers that are only touched by one thread
+/// (which is the case for the game object lists).
+/// </summary>
+template <typename T, size_t ElementsPerPage = 1024>
+class PooledListAllocator
+{
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind
+	{
+		using other = PooledListAllocator<U, ElementsPerPage>;
+	};
+
+	PooledListAllocator() noexcept = default;
+	template <typename U>
+	PooledListAllocator(const PooledListAllocator<U, ElementsPerPage>&) noexcept {}
+
+	T* allocate(size_t n)
+	{
+		if (n != 1)
+		{
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+		return reinterpret_cast<T*>(pool().allocate());
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		if (n != 1)
+		{
+			::operator delete(p);
+			return;
+		}
+		pool().deallocate(reinterpret_cast<Slot*>(p));
+	}
+
+	friend bool operator==(const PooledListAllocator&, const PooledListAllocator&) noexcept { return true; }
+	friend bool operator!=(const PooledListAllocator&, const PooledListAllocator&) noexcept { return false; }
+
+private:
+	union Slot
+	{
+		Slot* next;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+	};
+
+	class Pool
+	{
+	public:
+		Slot* allocate()
+		{
+			if (freeList == nullptr)
+			{
+				addPage();
+			}
+			Slot* slot = freeList;
+			freeList = slot->next;
+			return slot;
+		}
+
+		void deallocate(Slot* slot) noexcept
+		{
+			slot->next = freeList;
+			freeList = slot;
+		}
+
+	private:
+		void addPage()
+		{
+			pages.emplace_back(new Slot[ElementsPerPage]);
+			Slot* page = pages.back().get();
+			// Chain the slots so that they are handed out in address order
+			for (size_t i = ElementsPerPage; i-- > 0; )
+			{
+				page[i].next = freeList;
+				freeList = &page[i];
+			}
+		}
+
+		std::vector<std::unique_ptr<Slot[]>> pages;
+		Slot* freeList = nullptr;
+	};
+
+	static Pool& pool()
+	{
+		// Intentionally never destroyed: containers with static storage duration
+		// may still free their nodes after this function's statics would be gone.
+		static Pool* instance = new Pool();
+		return *instance;
+	}
+};
@@ -1829,7 +1829,7 @@ VkPSO::VkPSO(vk::Device _dev,
 		.setPMultisampleState(&multisampleState)
 		.setRenderPass(rp);
 
-	vk::ResultValue<vk::Pipeline> result = dev.createGraphicsPipeline(vk::PipelineCache(), pso, nullptr, *pVkDynLoader);
+	vk::ResultValue<vk::Pipeline> result = dev.createGraphicsPipeline(root->pipelineCache, pso, nullptr, *pVkDynLoader);
 	switch (result.result)
 	{
 		case vk::Result::eSuccess:
@@ -3723,6 +3723,14 @@ void VkRoot::shutdown()
 	}
 	createdPipelines.clear();
 
+	// persist + destroy pipeline cache
+	if (pipelineCache)
+	{
+		savePipelineCache();
+		dev.destroyPipelineCache(pipelineCache, nullptr, vkDynLoader);
+		pipelineCache = vk::PipelineCache();
+	}
+
 	// destroy depth pass objects
 	for (auto f : renderPasses[DEPTH_RENDER_PASS_ID].fbo)
 	{
@@ -4815,6 +4823,8 @@ bool VkRoot::_initialize(const gfx_api::backend_Impl_Factory& impl, int32_t anti
 		return false;
 	}
 
+	createPipelineCache();
+
 	getQueues();
 
 	ASSERT(renderPasses.empty(), "Non-empty renderPasses vector?");
@@ -5067,6 +5077,151 @@ bool VkRoot::createLogicalDevice()
 	return true;
 }
 
+#define WZ_VK_PIPELINE_CACHE_DIR "cache"
+static const char vkPipelineCachePath[] = WZ_VK_PIPELINE_CACHE_DIR "/vk_pipeline_cache.bin";
+
+// Header that prefixes the driver's pipeline cache blob on disk
+// The driver blob is only handed back to the same driver + device that produced it
+struct WzVkPipelineCacheFileHeader
+{
+	uint32_t magic;
+	uint32_t headerSize;
+	uint32_t vendorID;
+	uint32_t deviceID;
+	uint32_t driverVersion;
+	uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+	uint32_t reserved;	// explicit padding (always 0), so that no uninitialized bytes are written to the file
+	uint64_t dataSize;
+};
+static_assert(sizeof(WzVkPipelineCacheFileHeader) == 5 * sizeof(uint32_t) + VK_UUID_SIZE + sizeof(uint32_t) + sizeof(uint64_t), "WzVkPipelineCacheFileHeader must not contain implicit padding");
+static const uint32_t WZ_VK_PIPELINE_CACHE_MAGIC = 0x43505A57; // "WZPC"
+
+static WzVkPipelineCacheFileHeader makePipelineCacheFileHeader(const vk::PhysicalDeviceProperties& props, uint64_t dataSize)
+{
+	WzVkPipelineCacheFileHeader header = {};
+	header.magic = WZ_VK_PIPELINE_CACHE_MAGIC;
+	header.headerSize = static_cast<uint32_t>(sizeof(WzVkPipelineCacheFileHeader));
+	header.vendorID = props.vendorID;
+	header.deviceID = props.deviceID;
+	header.driverVersion = props.driverVersion;
+	memcpy(header.pipelineCacheUUID, props.pipelineCacheUUID.data(), VK_UUID_SIZE);
+	header.dataSize = dataSize;
+	return header;
+}
+
+// Returns the stored driver pipeline cache data, or an empty vector if there is none or it was produced by a different driver / device
+static std::vector<uint8_t> loadPipelineCacheData(const vk::PhysicalDeviceProperties& props)
+{
+	if (!PHYSFS_exists(vkPipelineCachePath))
+	{
+		return {};
+	}
+	PHYSFS_file *fileHandle = PHYSFS_openRead(vkPipelineCachePath);
+	if (fileHandle == nullptr)
+	{
+		return {};
+	}
+
+	std::vector<uint8_t> data;
+	WzVkPipelineCacheFileHeader header = {};
+	const WzVkPipelineCacheFileHeader expected = makePipelineCacheFileHeader(props, 0);
+	const PHYSFS_sint64 filesize = PHYSFS_fileLength(fileHandle);
+	if (WZ_PHYSFS_readBytes(fileHandle, &header, sizeof(header)) != sizeof(header)
+		|| header.magic != expected.magic
+		|| header.headerSize != expected.headerSize
+		|| header.vendorID != expected.vendorID
+		|| header.deviceID != expected.deviceID
+		|| header.driverVersion != expected.driverVersion
+		|| memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+	{
+		debug(LOG_3D, "Discarding pipeline cache from a different driver / device");
+	}
+	else if (filesize < 0 || header.dataSize != static_cast<uint64_t>(filesize) - sizeof(header) || header.dataSize > static_cast<uint64_t>(std::numeric_limits<PHYSFS_sint32>::max()))
+	{
+		debug(LOG_3D, "Discarding truncated pipeline cache");
+	}
+	else
+	{
+		data.resize(static_cast<size_t>(header.dataSize));
+		if (WZ_PHYSFS_readBytes(fileHandle, data.data(), static_cast<PHYSFS_uint32>(data.size())) != static_cast<PHYSFS_sint64>(data.size()))
+		{
+			data.clear();
+		}
+	}
+	PHYSFS_close(fileHandle);
+	return data;
+}
+
+void VkRoot::createPipelineCache()
+{
+	ASSERT(dev, "Logical device is null");
+
+	const std::vector<uint8_t> initialData = loadPipelineCacheData(physDeviceProps);
+	auto createInfo = vk::PipelineCacheCreateInfo()
+		.setInitialDataSize(initialData.size())
+		.setPInitialData(initialData.empty() ? nullptr : initialData.data());
+	try
+	{
+		pipelineCache = dev.createPipelineCache(createInfo, nullptr, vkDynLoader);
+		debug(LOG_3D, "Created pipeline cache (initial data: %zu bytes)", initialData.size());
+	}
+	catch (const vk::SystemError& e)
+	{
+		debug(LOG_3D, "createPipelineCache failed: %s", e.what());
+		pipelineCache = vk::PipelineCache();
+		if (!initialData.empty())
+		{
+			// the driver rejected the stored data - start over with an empty cache
+			try
+			{
+				pipelineCache = dev.createPipelineCache(vk::PipelineCacheCreateInfo(), nullptr, vkDynLoader);
+			}
+			catch (const vk::SystemError& e2)
+			{
+				debug(LOG_3D, "createPipelineCache failed: %s", e2.what());
+				pipelineCache = vk::PipelineCache();
+			}
+		}
+	}
+}
+
+void VkRoot::savePipelineCache()
+{
+	ASSERT_OR_RETURN(, pipelineCache, "No pipeline cache");
+
+	std::vector<uint8_t> data;
+	try
+	{
+		data = dev.getPipelineCacheData(pipelineCache, vkDynLoader);
+	}
+	catch (const vk::SystemError& e)
+	{
+		debug(LOG_3D, "getPipelineCacheData failed: %s", e.what());
+		return;
+	}
+	if (data.empty() || data.size() > static_cast<size_t>(std::numeric_limits<PHYSFS_sint32>::max()))
+	{
+		return;
+	}
+
+	PHYSFS_mkdir(WZ_VK_PIPELINE_CACHE_DIR);
+	PHYSFS_file *fileHandle = PHYSFS_openWrite(vkPipelineCachePath);
+	if (fileHandle == nullptr)
+	{
+		debug(LOG_3D, "Could not open %s for writing: %s", vkPipelineCachePath, WZ_PHYSFS_getLastError());
+		return;
+	}
+	const WzVkPipelineCacheFileHeader header = makePipelineCacheFileHeader(physDeviceProps, data.size());
+	bool success = WZ_PHYSFS_writeBytes(fileHandle, &header, sizeof(header)) == sizeof(header)
+		&& WZ_PHYSFS_writeBytes(fileHandle, data.data(), static_cast<PHYSFS_uint32>(data.size())) == static_cast<PHYSFS_sint64>(data.size());
+	PHYSFS_close(fileHandle);
+	if (!success)
+	{
+		// never leave a partial file behind
+		PHYSFS_delete(vkPipelineCachePath);
+	}
+}
+
 bool VkRoot::createAllocator()
 {
 	ASSERT(physicalDevice, "Physical device is null");
@@ -741,6 +741,9 @@ struct VkRoot final : gfx_api::context
 	std::vector<BuiltPipelineRegistry> createdPipelines;
 	VkPSO* currentPSO = nullptr;
 
+	// pipeline cache (persisted across runs, see createPipelineCache() / savePipelineCache())
+	vk::PipelineCache pipelineCache;
+
 	bool validationLayer = false;
 	bool debugCallbacksEnabled = true;
 	bool debugUtilsExtEnabled = false;
@@ -792,6 +795,8 @@ private:
 	void getQueueFamiliesInfo();
 	bool createLogicalDevice();
 	bool createAllocator();
+	void createPipelineCache();
+	void savePipelineCache();
 	void getQueues();
 	bool createSwapchain(bool allowHandleSurfaceLost = true);
 	void rebuildPipelinesIfNecessary();
@@ -54,6 +54,8 @@
 
 #define NUM_RADAR_TEXTURES 2
 static GFX *radarGfx[NUM_RADAR_TEXTURES] = {nullptr};
+static WzRect radarGfxOutdated[NUM_RADAR_TEXTURES]; ///< Area of each radar texture that no longer matches the radar bitmap
+static iV_Image radarUpdateBitmap; ///< Scratch buffer for partial radar texture uploads
 static size_t currRadarGfx = 0;
 
 /***************************************************************************/
@@ -130,6 +132,13 @@ void GFX::updateTexture(const iV_Image& image /*= nullptr*/)
 	mTexture->upload(0u, image);
 }
 
+void GFX::updateTextureRegion(const iV_Image& image, size_t offset_x, size_t offset_y)
+{
+	ASSERT(mType == GFX_TEXTURE, "Wrong GFX type");
+	ASSERT_OR_RETURN(, mTexture != nullptr, "Null texture??");
+	mTexture->upload_sub(0u, offset_x, offset_y, image);
+}
+
 void GFX::buffers(int vertices, const void *vertBuf, const void *auxBuf)
 {
 	if (!mBuffers[VBO_VERTEX])
@@ -222,7 +231,7 @@ static void pie_DrawRect(float x0, float y0, float x1, float y1, PIELIGHT colour
 	PSO::get().unbind_vertex_buffers(pie_internal::rectBuffer);
 }
 
-void pie_DrawMultiRect(std::vector<PIERECT_DrawRequest> rects)
+void pie_DrawMultiRect(const std::vector<PIERECT_DrawRequest> &rects)
 {
 	if (rects.empty()) { return; }
 
@@ -232,17 +241,13 @@ void pie_DrawMultiRect(std::vector<PIERECT_DrawRequest> rects)
 
 	for (auto it = rects.begin(); it != rects.end(); ++it)
 	{
-		if (it->x0 > it->x1)
-		{
-			std::swap(it->x0, it->x1);
-		}
-		if (it->y0 > it->y1)
-		{
-			std::swap(it->y0, it->y1);
-		}
+		const int x0 = std::min(it->x0, it->x1);
+		const int x1 = std::max(it->x0, it->x1);
+		const int y0 = std::min(it->y0, it->y1);
+		const int y1 = std::max(it->y0, it->y1);
 		const auto& colour = it->color;
-		const auto& center = Vector2f(it->x0, it->y0);
-		const auto& mvp = projectionMatrix * glm::translate(Vector3f(center, 0.f)) * glm::scale(glm::vec3(it->x1 - it->x0, it->y1 - it->y0, 1.f));
+		const auto& center = Vector2f(x0, y0);
+		const auto& mvp = projectionMatrix * glm::translate(Vector3f(center, 0.f)) * glm::scale(glm::vec3(x1 - x0, y1 - y0, 1.f));
 		gfx_api::BoxFillPSO::get().bind_constants({ mvp, glm::vec2(0.f), glm::vec2(0.f),
 			glm::vec4(colour.vector[0] / 255.f, colour.vector[1] / 255.f, colour.vector[2] / 255.f, colour.vector[3] / 255.f) });
 		if (!didEnableRect)
@@ -925,7 +930,9 @@ bool pie_ShutdownRadar()
 	{
 		delete radarGfx[i];
 		radarGfx[i] = nullptr;
+		radarGfxOutdated[i] = WzRect();
 	}
+	radarUpdateBitmap.clear();
 	currRadarGfx = 0;
 	pie_ViewingWindow_Shutdown();
 	return true;
@@ -940,6 +947,7 @@ void pie_SetRadar(gfx_api::gfxFloat x, gfx_api::gfxFloat y, gfx_api::gfxFloat wi
 			continue;
 		}
 		radarGfx[i]->makeTexture(twidth, theight, gfx_api::pixel_format::FORMAT_RGBA8_UNORM_PACK8, std::string("mem::radarTexture[") + std::to_string(i) + "]");
+		radarGfxOutdated[i] = WzRect(0, 0, static_cast<int>(twidth), static_cast<int>(theight));
 		//	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);  // Want GL_LINEAR (or GL_LINEAR_MIPMAP_NEAREST) for min filter, but GL_NEAREST for mag filter. // TODO: Add a gfx_api::sampler_type to handle this case? bilinear, but nearest for mag?
 		gfx_api::gfxFloat texcoords[] = { 0.0f, 0.0f,  1.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f };
 		gfx_api::gfxFloat vertices[] = { x, y,  x + width, y,  x, y + height,  x + width, y + height };
@@ -950,12 +958,65 @@ void pie_SetRadar(gfx_api::gfxFloat x, gfx_api::gfxFloat y, gfx_api::gfxFloat wi
 /** Store radar texture with given width and height. */
 void pie_DownLoadRadar(const iV_Image& bitmap)
 {
+	pie_DownLoadRadar(bitmap, WzRect(0, 0, static_cast<int>(bitmap.width()), static_cast<int>(bitmap.height())));
+}
+
+static inline bool radarRectIsEmpty(const WzRect& rect)
+{
+	return rect.width() <= 0 || rect.height() <= 0;
+}
+
+/** Update the radar texture, only uploading the parts of the bitmap that changed since the texture was last updated. */
+void pie_DownLoadRadar(const iV_Image& bitmap, const WzRect& changedRect)
+{
+	const WzRect bitmapRect(0, 0, static_cast<int>(bitmap.width()), static_cast<int>(bitmap.height()));
+	const WzRect changed = changedRect.intersectionWith(bitmapRect);
+	if (!radarRectIsEmpty(changed))
+	{
+		for (size_t i = 0; i < NUM_RADAR_TEXTURES; ++i)
+		{
+			radarGfxOutdated[i] = radarRectIsEmpty(radarGfxOutdated[i]) ? changed : radarGfxOutdated[i].minimumBoundingRect(changed);
+		}
+	}
+	if (radarRectIsEmpty(radarGfxOutdated[currRadarGfx]))
+	{
+		return; // the texture currently displayed is already up to date
+	}
+
 	currRadarGfx++;
 	if (currRadarGfx >= NUM_RADAR_TEXTURES)
 	{
 		currRadarGfx = 0;
 	}
-	radarGfx[currRadarGfx]->updateTexture(bitmap);
+	// The other textures may lag behind by several updates, so upload everything that changed since this one was last written
+	const WzRect update = radarGfxOutdated[currRadarGfx].intersectionWith(bitmapRect);
+	radarGfxOutdated[currRadarGfx] = WzRect();
+	if (radarRectIsEmpty(update))
+	{
+		return;
+	}
+	if (update == bitmapRect)
+	{
+		radarGfx[currRadarGfx]->updateTexture(bitmap);
+		return;
+	}
+
+	const unsigned int channels = bitmap.channels();
+	if (radarUpdateBitmap.width() != static_cast<unsigned int>(update.width()) || radarUpdateBitmap.height() != static_cast<unsigned int>(update.height()) || radarUpdateBitmap.channels() != channels)
+	{
+		radarUpdateBitmap.allocate(update.width(), update.height(), channels);
+	}
+	const size_t srcRowLength = static_cast<size_t>(bitmap.width()) * channels;
+	const size_t dstRowLength = static_cast<size_t>(update.width()) * channels;
+	const unsigned char *src = bitmap.bmp() + static_cast<size_t>(update.top()) * srcRowLength + static_cast<size_t>(update.left()) * channels;
+	unsigned char *dst = radarUpdateBitmap.bmp_w();
+	for (int row = 0; row < update.height(); ++row)
+	{
+		memcpy(dst, src, dstRowLength);
+		src += srcRowLength;
+		dst += dstRowLength;
+	}
+	radarGfx[currRadarGfx]->updateTextureRegion(radarUpdateBitmap, update.left(), update.top());
 }
 
 /** Display radar texture using the given height and width, depending on zoom level. */
@@ -97,6 +97,9 @@ public:
 	/// Upload given memory buffer to already allocated texture space on the GPU
 	void updateTexture(const iV_Image& image /*= nullptr*/);
 
+	/// Upload given memory buffer to a sub-region (starting at offset_x, offset_y) of the already allocated texture space on the GPU
+	void updateTextureRegion(const iV_Image& image, size_t offset_x, size_t offset_y);
+
 	/// Upload vertex and texture buffer data to the GPU
 	void buffers(int vertices, const void *vertBuf, const void *texBuf);
 
@@ -145,7 +148,7 @@ static inline void iV_Box(int x0, int y0, int x1, int y1, PIELIGHT first)
 void pie_BoxFill(int x0, int y0, int x1, int y1, PIELIGHT colour);
 void pie_BoxFillf(float x0, float y0, float x1, float y1, PIELIGHT colour);
 void pie_BoxFill_alpha(int x0, int y0, int x1, int y1, PIELIGHT colour);
-void pie_DrawMultiRect(std::vector<PIERECT_DrawRequest> rects);
+void pie_DrawMultiRect(const std::vector<PIERECT_DrawRequest> &rects);
 class BatchedMultiRectRenderer
 {
 public:
@@ -270,6 +273,7 @@ bool assertValidImage(IMAGEFILE *imageFile, unsigned id);
 bool pie_InitRadar();
 bool pie_ShutdownRadar();
 void pie_DownLoadRadar(const iV_Image& bitmap);
+void pie_DownLoadRadar(const iV_Image& bitmap, const WzRect& changedRect);
 void pie_RenderRadar(const glm::mat4 &modelViewProjectionMatrix);
 void pie_SetRadar(gfx_api::gfxFloat x, gfx_api::gfxFloat y, gfx_api::gfxFloat width, gfx_api::gfxFloat height, size_t twidth, size_t theight);
 
@@ -1003,6 +1003,26 @@ private:
 	size_t translucentInstancesCount = 0;
 	size_t additiveInstancesCount = 0;
 
+	// The bucket renderer queues identical meshes back to back, so remember where the last one went and skip the hash lookup
+	struct LastInstanceList
+	{
+		MeshInstanceKey key;
+		std::vector<SHAPE>* list = nullptr;
+	};
+	LastInstanceList lastInstanceMeshes;
+	LastInstanceList lastInstanceTranslucentMeshes;
+	LastInstanceList lastInstanceAdditiveMeshes;
+
+	static inline std::vector<SHAPE>& getInstanceList(std::unordered_map<MeshInstanceKey, std::vector<SHAPE>>& meshes, LastInstanceList& last, const MeshInstanceKey& key)
+	{
+		if (last.list == nullptr || last.key != key)
+		{
+			last.key = key;
+			last.list = &meshes[key]; // references to unordered_map elements stay valid until they are erased
+		}
+		return *last.list;
+	}
+
 	std::vector<SHAPE> tshapes;
 	std::vector<SHAPE> shapes;
 
@@ -1055,6 +1075,9 @@ void InstancedMeshRenderer::clear()
 	instanceMeshes.clear();
 	instanceTranslucentMeshes.clear();
 	instanceAdditiveMeshes.clear();
+	lastInstanceMeshes = LastInstanceList();
+	lastInstanceTranslucentMeshes = LastInstanceList();
+	lastInstanceAdditiveMeshes = LastInstanceList();
 	instancesCount = 0;
 	translucentInstancesCount = 0;
 	additiveInstancesCount = 0;
@@ -1128,7 +1151,7 @@ bool InstancedMeshRenderer::Draw3DShape(const iIMDShape *shape, int frame, PIELI
 	{
 		if (useInstancedRendering)
 		{
-			instanceAdditiveMeshes[currentState].push_back(tshape);
+			getInstanceList(instanceAdditiveMeshes, lastInstanceAdditiveMeshes, currentState).push_back(tshape);
 		}
 		else
 		{
@@ -1140,7 +1163,7 @@ bool InstancedMeshRenderer::Draw3DShape(const iIMDShape *shape, int frame, PIELI
 	{
 		if (useInstancedRendering)
 		{
-			instanceTranslucentMeshes[currentState].push_back(tshape);
+			getInstanceList(instanceTranslucentMeshes, lastInstanceTranslucentMeshes, currentState).push_back(tshape);
 		}
 		else
 		{
@@ -1178,7 +1201,7 @@ bool InstancedMeshRenderer::Draw3DShape(const iIMDShape *shape, int frame, PIELI
 		}
 		if (useInstancedRendering)
 		{
-			instanceMeshes[currentState].push_back(tshape);
+			getInstanceList(instanceMeshes, lastInstanceMeshes, currentState).push_back(tshape);
 		}
 		else
 		{
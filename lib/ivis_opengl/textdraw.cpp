@@ -513,6 +513,35 @@ private:
 
 static FTCache* glyphCache = nullptr;
 
+struct TextLayoutCacheKey
+{
+	WzString text;
+	iV_fonts fontID;
+
+	TextLayoutCacheKey(const WzString& text, iV_fonts fontID)
+	: text(text), fontID(fontID)
+	{ }
+
+	bool operator==(const TextLayoutCacheKey& other) const
+	{
+		return fontID == other.fontID && text == other.text;
+	}
+};
+
+namespace std {
+
+	template <>
+	struct hash<TextLayoutCacheKey>
+	{
+		std::size_t operator()(const TextLayoutCacheKey& k) const
+		{
+			return std::hash<WzString>()(k.text)
+				 ^ (std::hash<int>()(static_cast<int>(k.fontID)) << 1);
+		}
+	};
+
+}
+
 struct TextRun
 {
 	int startOffset;
@@ -645,16 +674,26 @@ struct TextShaper
 	};
 
 	TextShaper()
+	: m_shapingCache(256, 32)
+	, m_layoutMetricsCache(1024, 128)
 	{ }
 
 	~TextShaper()
 	{ }
 
+	// Drops all cached shaping results and layout metrics
+	// Must be called whenever the font faces (or the scale factors they were created with) change,
+	// as cached glyph positions reference the faces and are measured in (scaled) pixels
+	void clearCaches()
+	{
+		m_shapingCache.clear();
+		m_layoutMetricsCache.clear();
+	}
+
 	// Returns the maximum text run length (in WzString characters) that fits within a max width (supplied *IN PIXELS*)
 	uint32_t getTextMaxLenForWidth(const WzString& text, iV_fonts fontID, uint32_t maxWidthInPixels, bool rightToLeft)
 	{
-		std::vector<uint32_t> codePoints = text.toUtf32();
-		auto shapingResult = shapeText(codePoints, fontID);
+		const ShapingResult& shapingResult = *getCachedShapingResult(text, fontID);
 
 		if (shapingResult.glyphes.empty())
 		{
@@ -722,8 +761,20 @@ struct TextShaper
 	// Returns the text width and height *IN PIXELS*
 	TextLayoutMetrics getTextMetrics(const WzString& text, iV_fonts fontID)
 	{
-		const ShapingResult& shapingResult = shapeText(text, fontID);
+		TextLayoutCacheKey key(text, fontID);
+		TextLayoutMetrics cachedMetrics;
+		if (m_layoutMetricsCache.tryGet(key, cachedMetrics))
+		{
+			return cachedMetrics;
+		}
+		TextLayoutMetrics metrics = calculateTextMetrics(*getCachedShapingResult(text, fontID));
+		m_layoutMetricsCache.insert(key, metrics);
+		return metrics;
+	}
 
+private:
+	TextLayoutMetrics calculateTextMetrics(const ShapingResult& shapingResult)
+	{
 		if (shapingResult.glyphes.empty())
 		{
 			return TextLayoutMetrics(shapingResult.x_advance / 64, shapingResult.y_advance / 64);
@@ -756,6 +807,23 @@ struct TextShaper
 		return TextLayoutMetrics(std::max(texture_width, x_advance), std::max(texture_height, y_advance));
 	}
 
+	// Shaping (fribidi + harfbuzz) is by far the most expensive part of measuring a string, and the
+	// same strings are measured over and over again by the UI layout code - so keep recent results around
+	std::shared_ptr<const ShapingResult> getCachedShapingResult(const WzString& text, iV_fonts fontID)
+	{
+		TextLayoutCacheKey key(text, fontID);
+		std::shared_ptr<const ShapingResult> result;
+		if (m_shapingCache.tryGet(key, result))
+		{
+			return result;
+		}
+		result = std::make_shared<const ShapingResult>(shapeText(text, fontID));
+		m_shapingCache.insert(key, result);
+		return result;
+	}
+
+public:
+
 #if defined(WZ_FRIBIDI_ENABLED)
 	FriBidiParType getBaseDirection()
 	{
@@ -775,7 +843,8 @@ struct TextShaper
 	// Draws the text and returns the text buffer, width and height, etc *IN PIXELS*
 	DrawTextResult drawText(const WzString& text, iV_fonts fontID)
 	{
-		ShapingResult shapingResult = shapeText(text, fontID);
+		std::shared_ptr<const ShapingResult> pShapingResult = getCachedShapingResult(text, fontID);
+		const ShapingResult& shapingResult = *pShapingResult;
 
 		if (shapingResult.glyphes.empty())
 		{
@@ -1106,6 +1175,10 @@ struct TextShaper
 		run.glyphInfos = hb_buffer_get_glyph_infos(run.buffer, &run.glyphCount);
 		run.glyphPositions = hb_buffer_get_glyph_positions(run.buffer, &run.glyphCount);
 	}
+
+private:
+	lru11::Cache<TextLayoutCacheKey, std::shared_ptr<const ShapingResult>> m_shapingCache;
+	lru11::Cache<TextLayoutCacheKey, TextLayoutMetrics> m_layoutMetricsCache;
 };
 
 /***************************************************************************/
@@ -1334,6 +1407,7 @@ void iV_TextInit(unsigned int horizScalePercentage, unsigned int vertScalePercen
 
 void iV_TextShutdown()
 {
+	getShaper().clearCaches();
 	glyphCache->clear();
 	delete glyphCache;
 	glyphCache = nullptr;
@@ -1358,6 +1432,11 @@ void iV_TextUpdateScaleFactor(unsigned int horizScalePercentage, unsigned int ve
 	iV_TextInit(horizScalePercentage, vertScalePercentage);
 }
 
+void iV_TextLanguageChanged()
+{
+	getShaper().clearCaches();
+}
+
 static WzText& iV_Internal_GetEllipsis(iV_fonts fontID)
 {
 	auto it = fontToEllipsisMap.find(fontID);
@@ -132,6 +132,8 @@ void iV_TextInit(unsigned int horizScalePercentage, unsigned int vertScalePercen
  */
 void iV_TextUpdateScaleFactor(unsigned int horizScalePercentage, unsigned int vertScalePercentage);
 void iV_TextShutdown();
+/// Must be called after setLanguage(), as cached text layouts depend on the language's base direction
+void iV_TextLanguageChanged();
 void iV_font(const char *fontName, const char *fontFace, const char *fontFaceBold);
 
 int iV_GetEllipsisWidth(iV_fonts fontID);
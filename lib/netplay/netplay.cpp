@@ -1777,6 +1777,28 @@ size_t NETgetStatistic(NetStatisticType type, bool sent, bool isTotal)
 	return nStatsLastSec.*statsType.*statisticType - nStatsSecondLastSec.*statsType.*statisticType;
 }
 
+optional<size_t> NETgetPendingWriteBytes(uint32_t player)
+{
+	if (activeConnProvider == nullptr || player >= MAX_CONNECTED_PLAYERS)
+	{
+		return nullopt;
+	}
+	IClientConnection* conn = nullptr;
+	if (NetPlay.isHost)
+	{
+		conn = connected_bsocket[player];
+	}
+	else if (player == NetPlay.hostPlayer)
+	{
+		conn = bsocket;
+	}
+	if (conn == nullptr)
+	{
+		return nullopt;
+	}
+	return PendingWritesManagerMap::instance().get(*activeConnProvider).pendingBytes(conn);
+}
+
 static std::set<uint32_t> netSendPendingDisconnectPlayerIndexes;
 
 void NETsendProcessDelayedActions()
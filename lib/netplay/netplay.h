@@ -380,6 +380,7 @@ void NETinitPortMapping();
 
 enum NetStatisticType {NetStatisticRawBytes, NetStatisticUncompressedBytes, NetStatisticPackets};
 size_t NETgetStatistic(NetStatisticType type, bool sent, bool isTotal = false);     // Return some statistic. Call regularly for good results.
+optional<size_t> NETgetPendingWriteBytes(uint32_t player);	// Bytes still queued for sending to player (or, on clients, to the host if player is the host), if connected.
 
 void NETplayerKicked(UDWORD index);			// Cleanup after player has been kicked
 
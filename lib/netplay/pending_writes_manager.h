@@ -115,6 +115,27 @@ public:
 		});
 	}
 
+	/// <summary>
+	/// Number of bytes queued for `conn` that haven't been written to the socket yet (thread-safe).
+	/// </summary>
+	size_t pendingBytes(IClientConnection* conn) const
+	{
+		size_t result = 0;
+		if (!mtx_)
+		{
+			return result;
+		}
+		executeUnderLock([this, conn, &result]
+		{
+			auto it = pendingWrites_.find(conn);
+			if (it != pendingWrites_.end())
+			{
+				result = it->second.size();
+			}
+		});
+		return result;
+	}
+
 	void clearPendingWrites(IClientConnection* conn)
 	{
 		executeUnderLock([this, conn]
@@ -35,7 +35,10 @@
 #include "openal_error.h"
 #include "mixer.h"
 
+#include <algorithm>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 // defines
 #define NO_SAMPLE				- 2
@@ -44,6 +47,9 @@
 // global variables
 static std::list<AUDIO_SAMPLE *> g_psSampleList;
 static std::list<AUDIO_SAMPLE *> g_psSampleQueue;
+// playing samples (in g_psSampleList) grouped by the object they belong to, so that objects can drop their sounds without scanning the whole list
+// (each object's samples are kept in the order they were started)
+static std::unordered_map<const SIMPLE_OBJECT *, std::vector<std::list<AUDIO_SAMPLE *>::iterator>> g_psObjectSamples;
 static bool			g_bAudioEnabled = false;
 static bool			g_bAudioPaused = false;
 static AUDIO_SAMPLE g_sPreviousSample;
@@ -176,6 +182,7 @@ bool audio_Shutdown(void)
 	// free sample heap
 	g_psSampleList.clear();
 	g_psSampleQueue.clear();
+	g_psObjectSamples.clear();
 
 	return bOK;
 }
@@ -263,6 +270,49 @@ static void audio_RemoveSample(std::list<AUDIO_SAMPLE *>& ppsSampleList, AUDIO_S
 	ppsSampleList.erase(it);
 }
 
+//*
+//
+// audio_IndexObjectSample Remembers that the (just added) playing sample belongs to its psObj
+
+//*
+// =======================================================================================================================
+// =======================================================================================================================
+//
+static void audio_IndexObjectSample(std::list<AUDIO_SAMPLE *>::iterator sampleIt)
+{
+	const SIMPLE_OBJECT *psObj = (*sampleIt)->psObj;
+	if (psObj != nullptr)
+	{
+		g_psObjectSamples[psObj].push_back(sampleIt);
+	}
+}
+
+//*
+//
+// audio_UnindexObjectSample Forgets the playing sample's psObj; must be called before psObj is changed or the sample leaves g_psSampleList
+
+//*
+// =======================================================================================================================
+// =======================================================================================================================
+//
+static void audio_UnindexObjectSample(AUDIO_SAMPLE *psSample)
+{
+	if (psSample->psObj == nullptr)
+	{
+		return;
+	}
+	auto objIt = g_psObjectSamples.find(psSample->psObj);
+	ASSERT_OR_RETURN(, objIt != g_psObjectSamples.end(), "audio_UnindexObjectSample: object not found in index");
+	auto& samples = objIt->second;
+	auto it = std::find_if(samples.begin(), samples.end(), [psSample](std::list<AUDIO_SAMPLE *>::iterator sampleIt) { return *sampleIt == psSample; });
+	ASSERT_OR_RETURN(, it != samples.end(), "audio_UnindexObjectSample: sample not found in index");
+	samples.erase(it);
+	if (samples.empty())
+	{
+		g_psObjectSamples.erase(objIt);
+	}
+}
+
 //*
 // =======================================================================================================================
 // =======================================================================================================================
@@ -543,12 +593,14 @@ void audio_Update()
 	sound_SetPlayerOrientation(angle);
 
 	// loop through 3D sounds and remove if finished or update position
-	mutating_list_iterate(g_psSampleList, [](AUDIO_SAMPLE* psSample)
+	mutating_list_iterate(g_psSampleList, [](std::list<AUDIO_SAMPLE *>::iterator sampleIt)
 	{
+		AUDIO_SAMPLE* psSample = *sampleIt;
 		// remove finished samples from list
 		if (psSample->bFinishedPlaying == true)
 		{
-			audio_RemoveSample(g_psSampleList, psSample);
+			audio_UnindexObjectSample(psSample);
+			g_psSampleList.erase(sampleIt);
 			free(psSample);
 		}
 		else // check looping sound callbacks for finished condition
@@ -559,6 +611,7 @@ void audio_Update()
 					|| (psSample->pCallback != nullptr && psSample->pCallback(psSample->psObj) == false))
 				{
 					sound_StopTrack(psSample);
+					audio_UnindexObjectSample(psSample);
 					psSample->psObj = nullptr;
 				}
 				else	// update sample position
@@ -725,6 +778,7 @@ static bool audio_Play3DTrack(SDWORD iX, SDWORD iY, SDWORD iZ, int iTrack, SIMPL
 	}
 
 	audio_AddSampleToHead(g_psSampleList, psSample);
+	audio_IndexObjectSample(g_psSampleList.begin());
 	return true;
 }
 
@@ -850,11 +904,19 @@ void audio_StopObjTrack(SIMPLE_OBJECT *psObj, int iTrack)
 		return;
 	}
 
-	// find sample
-	for (AUDIO_SAMPLE* psSample : g_psSampleList)
+	auto objIt = g_psObjectSamples.find(psObj);
+	if (objIt == g_psObjectSamples.end())
+	{
+		return;
+	}
+
+	// find sample (the most recently started one)
+	const auto& samples = objIt->second;
+	for (auto it = samples.rbegin(); it != samples.rend(); ++it)
 	{
+		AUDIO_SAMPLE* psSample = **it;
 		// If track has been found stop it and return
-		if (psSample->psObj == psObj && psSample->iTrack == iTrack)
+		if (psSample->iTrack == iTrack)
 		{
 			sound_StopTrack(psSample);
 			return;
@@ -975,6 +1037,7 @@ void audio_StopAll(void)
 		// invoked by stageThreeShutDown().
 		psSample->psObj = nullptr;
 	}
+	g_psObjectSamples.clear();
 
 	// empty sample queue
 	for (AUDIO_SAMPLE* psSample : g_psSampleQueue)
@@ -1016,77 +1079,39 @@ SDWORD audio_GetTrackID(const char *fileName)
 	return sound_GetTrackID(psTrack);
 }
 
-/** Loop through the list of playing and queued audio samples, and destroy any
- *  of them that refer to the given object.
+/** Destroy all playing audio samples that refer to the given object.
  *  \param psObj pointer to the object for which we must destroy all of its
  *               outstanding audio samples.
+ *  \note Queued samples are never attached to an object, so only the playing
+ *        samples have to be checked - via the per-object index, as this gets
+ *        called for every destroyed object and projectile.
  */
 void audio_RemoveObj(SIMPLE_OBJECT const *psObj)
 {
-	unsigned int count = 0;
-
-	// loop through queued sounds and check if a sample needs to be removed
-	mutating_list_iterate(g_psSampleQueue, [psObj, &count](AUDIO_SAMPLE* psSample)
-	{
-		if (psSample->psObj != psObj)
-		{
-			return IterationResult::CONTINUE_ITERATION;
-		}
-		// The current audio sample seems to refer to an object
-		// that is about to be destroyed. So destroy this
-		// sample as well.
-		AUDIO_SAMPLE* toRemove = psSample;
-
-		debug(LOG_MEMORY, "audio_RemoveObj: callback %p sample %d\n", reinterpret_cast<void*>(toRemove->pCallback), toRemove->iTrack);
-		// Remove sound from global active list
-		sound_RemoveActiveSample(toRemove);   //remove from global active list.
-
-		// Perform the actual task of destroying this sample
-		audio_RemoveSample(g_psSampleQueue, toRemove);
-		free(toRemove);
-
-		// Increment the deletion count
-		++count;
-
-		return IterationResult::CONTINUE_ITERATION;
-	});
-
-	if (count)
+	auto objIt = g_psObjectSamples.find(psObj);
+	if (objIt == g_psObjectSamples.end())
 	{
-		debug(LOG_MEMORY, "audio_RemoveObj: BASE_OBJECT* 0x%p was found %u times in the audio sample queue", static_cast<const void *>(psObj), count);
+		return;
 	}
+	// Take the samples out of the index first, the callbacks below may start new sounds
+	std::vector<std::list<AUDIO_SAMPLE *>::iterator> samples = std::move(objIt->second);
+	g_psObjectSamples.erase(objIt);
 
-	// Reset the deletion count
-	count = 0;
-
-	// loop through list of currently playing sounds and check if a sample needs to be removed
-	mutating_list_iterate(g_psSampleList, [psObj, &count](AUDIO_SAMPLE* psSample)
+	for (auto sampleIt : samples)
 	{
-		if (psSample->psObj != psObj)
-		{
-			return IterationResult::CONTINUE_ITERATION;
-		}
-		// The current audio sample seems to refer to an object
+		// The current audio sample refers to an object
 		// that is about to be destroyed. So destroy this
 		// sample as well.
-		AUDIO_SAMPLE* toRemove = psSample;
+		AUDIO_SAMPLE* toRemove = *sampleIt;
 
 		debug(LOG_MEMORY, "audio_RemoveObj: callback %p sample %d\n", reinterpret_cast<void*>(toRemove->pCallback), toRemove->iTrack);
 		// Stop this sound sample
 		sound_RemoveActiveSample(toRemove);   //remove from global active list.
 
 		// Perform the actual task of destroying this sample
-		audio_RemoveSample(g_psSampleList, toRemove);
+		g_psSampleList.erase(sampleIt);
 		free(toRemove);
-
-		// Increment the deletion count
-		++count;
-
-		return IterationResult::CONTINUE_ITERATION;
-	});
-
-	if (count)
-	{
-		debug(LOG_MEMORY, "audio_RemoveObj: ***Warning! psOBJ %p was found %u times in the list of playing audio samples", static_cast<const void *>(psObj), count);
 	}
+
+	debug(LOG_MEMORY, "audio_RemoveObj: ***Warning! psOBJ %p was found %zu times in the list of playing audio samples", static_cast<const void *>(psObj), samples.size());
 }
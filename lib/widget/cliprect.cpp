@@ -58,8 +58,19 @@ void ClipRectWidget::displayRecursive(const WidgetGraphicsContext &context)
 		.translatedBy(x() - offset.x, + y() - offset.y)
 		.clippedBy(WzRect(offset.x, offset.y, width(), height()));
 
-	for (auto child : children())
+	auto const &childWidgets = children();
+	size_t first = 0;
+	size_t last = childWidgets.size();
+	if (childrenInRangeFunc)
 	{
+		auto range = childrenInRangeFunc(offset.y, offset.y + height());
+		last = std::min(range.second, last);
+		first = std::min(range.first, last);
+	}
+
+	for (size_t idx = first; idx < last; ++idx)
+	{
+		auto const &child = childWidgets[idx];
 		if (child->visible())
 		{
 			child->displayRecursive(childrenContext);
@@ -67,6 +78,11 @@ void ClipRectWidget::displayRecursive(const WidgetGraphicsContext &context)
 	}
 }
 
+void ClipRectWidget::setChildrenInRangeFunc(const ChildrenInRange_Func& func)
+{
+	childrenInRangeFunc = func;
+}
+
 bool ClipRectWidget::isChildVisible(const std::shared_ptr<WIDGET>& child)
 {
 	ASSERT_OR_RETURN(false, child->parent() == shared_from_this(), "Not a child of this widget?");
@@ -30,6 +30,10 @@
 
 class ClipRectWidget : public WIDGET
 {
+public:
+	/// Returns the [first, last) range of children that may intersect the vertical span [top, bottom] (in child coordinates)
+	typedef std::function<std::pair<size_t, size_t> (int32_t top, int32_t bottom)> ChildrenInRange_Func;
+
 public:
 	ClipRectWidget() : WIDGET() {}
 
@@ -40,11 +44,13 @@ public:
 	bool setLeftOffset(uint16_t value);
 	uint16_t getTopOffset();
 	bool isChildVisible(const std::shared_ptr<WIDGET>& child);
+	void setChildrenInRangeFunc(const ChildrenInRange_Func& func);
 	int parentRelativeXOffset(int coord) const override;
 	int parentRelativeYOffset(int coord) const override;
 
 private:
 	glm::ivec2 offset = {0, 0};
+	ChildrenInRange_Func childrenInRangeFunc;
 };
 
 #endif // __INCLUDED_LIB_WIDGET_CLIPRECT_H__
@@ -32,6 +32,15 @@ void ScrollableListWidget::initialize()
 	attach(scrollBar = ScrollBarWidget::make());
 	attach(listView = std::make_shared<ClipRectWidget>());
 	scrollBar->show(false);
+	std::weak_ptr<ScrollableListWidget> pWeakThis(std::dynamic_pointer_cast<ScrollableListWidget>(shared_from_this()));
+	listView->setChildrenInRangeFunc([pWeakThis](int32_t top, int32_t bottom) -> std::pair<size_t, size_t> {
+		auto pThis = pWeakThis.lock();
+		if (!pThis)
+		{
+			return {0, 0};
+		}
+		return pThis->itemsInRange(top, bottom);
+	});
 	scrollbarWidth = SCROLLBAR_WIDTH;
 	backgroundColor.rgba = 0;
 	borderColor.rgba = 0;
@@ -59,7 +68,7 @@ void ScrollableListWidget::run(W_CONTEXT *psContext)
 uint32_t ScrollableListWidget::snappedOffset()
 {
 	const auto& items = listView->children();
-	for (size_t idx = 0; idx < items.size(); ++idx)
+	for (size_t idx = itemsInRange(scrollBar->position(), scrollBar->position()).first; idx < items.size(); ++idx)
 	{
 		const auto& child = items[idx];
 		if (child->geometry().bottom() < scrollBar->position())
@@ -167,18 +176,43 @@ void ScrollableListWidget::resizeChildren(uint32_t width)
 {
 	scrollableHeight = 0;
 	auto nextOffset = 0;
+	itemTops.clear();
+	itemBottoms.clear();
 	for (auto& child : listView->children())
 	{
 		if (!child->visible())
 		{
+			// hidden items take no space, but keep itemTops / itemBottoms sorted
+			itemTops.push_back(nextOffset);
+			itemBottoms.push_back(nextOffset);
 			continue;
 		}
 		child->setGeometry(0, nextOffset, width, child->height());
 		scrollableHeight = nextOffset + child->height();
+		itemTops.push_back(nextOffset);
+		itemBottoms.push_back(scrollableHeight);
 		nextOffset = scrollableHeight + itemSpacing;
 	}
 }
 
+/**
+ * Returns the [first, last) range of items that may intersect the vertical span [top, bottom] of the list view.
+ *
+ * Items are laid out top to bottom, so this is a binary search over the offsets cached by the last layout.
+ */
+std::pair<size_t, size_t> ScrollableListWidget::itemsInRange(int32_t top, int32_t bottom) const
+{
+	size_t numItems = listView->children().size();
+	if (layoutDirty || itemTops.size() != numItems)
+	{
+		// items were added or removed since the last layout
+		return {0, numItems};
+	}
+	size_t first = std::lower_bound(itemBottoms.begin(), itemBottoms.end(), top) - itemBottoms.begin();
+	size_t last = std::upper_bound(itemTops.begin() + first, itemTops.end(), bottom) - itemTops.begin();
+	return {first, last};
+}
+
 uint32_t ScrollableListWidget::calculateListViewHeight() const
 {
 	int32_t result = height() - static_cast<int32_t>(padding.top) - static_cast<int32_t>(padding.bottom);
@@ -297,8 +331,12 @@ void ScrollableListWidget::displayRecursive(WidgetGraphicsContext const& context
 	int y1 = y0 + listView->height();
 
 	int listViewTopOffset = listView->getTopOffset();
-	for (auto& child : listView->children())
+
+	auto const &items = listView->children();
+	auto range = itemsInRange(listViewTopOffset, listViewTopOffset + listView->height() + itemSpacing);
+	for (size_t idx = range.first; idx < range.second; ++idx)
 	{
+		auto const &child = items[idx];
 		int childY = child->y();
 		if (childY < listViewTopOffset)
 		{
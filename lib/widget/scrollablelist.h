@@ -102,9 +102,13 @@ private:
 	size_t topVisibleItemIdx = 0;
 	std::vector<PIERECT_DrawRequest> lineDraws;
 
+	std::vector<int32_t> itemTops;
+	std::vector<int32_t> itemBottoms;
+
 	uint32_t snappedOffset();
 	void updateLayout();
 	void resizeChildren(uint32_t width);
+	std::pair<size_t, size_t> itemsInRange(int32_t top, int32_t bottom) const;
 	uint32_t getScrollPositionForItem(size_t itemNum);
 };
 
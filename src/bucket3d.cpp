@@ -25,6 +25,7 @@
 
 #include "lib/framework/frame.h"
 #include "lib/framework/vector.h"
+#include "lib/framework/wzapp.h"
 #include "lib/ivis_opengl/piematrix.h"
 #include "lib/ivis_opengl/pieclip.h"
 
@@ -38,6 +39,9 @@
 #include "droid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
 
 #define CLIP_LEFT	((SDWORD)0)
 #define CLIP_RIGHT	((SDWORD)pie_GetVideoBufferWidth())
@@ -49,17 +53,178 @@
 
 struct BUCKET_TAG
 {
-	bool operator <(BUCKET_TAG const &b) const
-	{
-		return actualZ > b.actualZ;    // Sort in reverse z order.
-	}
-
 	RENDER_TYPE     objectType; //type of object held
 	void           *pObject;    //pointer to the object
-	int32_t         actualZ;
+	uint64_t        sortKey;    //see bucketSortKey()
 };
 
 static std::vector<BUCKET_TAG> bucketArray;
+static std::vector<BUCKET_TAG> bucketSortScratch;
+
+// Objects are culled / keyed in chunks of this many on the worker threads, smaller lists are done on the main thread
+#define BUCKET_CHUNK_SIZE	256
+#define BUCKET_MAX_WORKERS	3
+
+static WZ_THREAD *bucketWorkers[BUCKET_MAX_WORKERS];
+static unsigned bucketNumWorkers = 0;
+static bool bucketWorkersStarted = false;
+static WZ_SEMAPHORE *bucketJobStart = nullptr;
+static WZ_SEMAPHORE *bucketJobDone = nullptr;
+static std::atomic<bool> bucketWorkersQuit(false);
+static const std::function<void (size_t chunk)> *bucketJobFunc = nullptr;
+static size_t bucketJobChunks = 0;
+static std::atomic<size_t> bucketJobNextChunk(0);
+
+/**
+ * Builds the key the render list is sorted by (ascending).
+ * The upper 32 bits hold the z value, so that objects are drawn in reverse z order (as before).
+ * The lower 32 bits group tags with the same z (mostly objects keyed by texture page) by object
+ * type and mesh, so that identical meshes get queued back to back for the instanced mesh renderer.
+ */
+static inline uint64_t bucketSortKey(int32_t z, RENDER_TYPE objectType, const iIMDShape *pie)
+{
+	const uint64_t depth = static_cast<uint32_t>(INT32_MAX - z); // z is never negative here, larger z first
+	const uint32_t mesh = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pie) >> 4) & 0x0FFFFFFF;
+	return (depth << 32) | (static_cast<uint64_t>(objectType & 0xF) << 28) | mesh;
+}
+
+/** LSD radix sort of the render list by sortKey, one byte per pass. Passes where all keys share the same byte are skipped. */
+static void bucketRadixSort(std::vector<BUCKET_TAG> &tags)
+{
+	const size_t count = tags.size();
+	if (count < 2)
+	{
+		return;
+	}
+	bucketSortScratch.resize(count);
+	BUCKET_TAG *src = tags.data();
+	BUCKET_TAG *dst = bucketSortScratch.data();
+	for (unsigned shift = 0; shift < 64; shift += 8)
+	{
+		size_t offsets[256] = {0};
+		for (size_t i = 0; i < count; ++i)
+		{
+			++offsets[(src[i].sortKey >> shift) & 0xFF];
+		}
+		if (offsets[(src[0].sortKey >> shift) & 0xFF] == count)
+		{
+			continue; // all keys share this byte
+		}
+		size_t total = 0;
+		for (size_t &offset : offsets)
+		{
+			const size_t bucketCount = offset;
+			offset = total;
+			total += bucketCount;
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst[offsets[(src[i].sortKey >> shift) & 0xFF]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+	if (src != tags.data())
+	{
+		std::copy(src, src + count, tags.data());
+	}
+}
+
+/** Runs chunks of the current job until there are none left. */
+static void bucketRunJobChunks()
+{
+	size_t chunk;
+	while ((chunk = bucketJobNextChunk.fetch_add(1)) < bucketJobChunks)
+	{
+		(*bucketJobFunc)(chunk);
+	}
+}
+
+static int bucketWorkerThreadFunc(void *)
+{
+	while (true)
+	{
+		wzSemaphoreWait(bucketJobStart);
+		if (bucketWorkersQuit.load())
+		{
+			break;
+		}
+		bucketRunJobChunks();
+		wzSemaphorePost(bucketJobDone);
+	}
+	return 0;
+}
+
+static void bucketStartWorkers()
+{
+	bucketWorkersStarted = true;
+	const unsigned numCores = std::thread::hardware_concurrency();
+	bucketNumWorkers = std::min<unsigned>(BUCKET_MAX_WORKERS, numCores > 1 ? numCores - 1 : 0);
+	if (bucketNumWorkers == 0)
+	{
+		return;
+	}
+	bucketWorkersQuit = false;
+	bucketJobStart = wzSemaphoreCreate(0);
+	bucketJobDone = wzSemaphoreCreate(0);
+	for (unsigned i = 0; i < bucketNumWorkers; ++i)
+	{
+		bucketWorkers[i] = wzThreadCreate(bucketWorkerThreadFunc, nullptr, "wzRenderList");
+		wzThreadStart(bucketWorkers[i]);
+	}
+}
+
+/**
+ * Calls func(chunk) for every chunk of BUCKET_CHUNK_SIZE items out of count, spread over the worker
+ * threads and the calling thread, and returns once all chunks are done. func must not touch anything
+ * but the objects of its own chunk and its own per-chunk output.
+ */
+static void bucketParallelChunks(size_t count, const std::function<void (size_t chunk)> &func)
+{
+	const size_t numChunks = (count + BUCKET_CHUNK_SIZE - 1) / BUCKET_CHUNK_SIZE;
+	if (numChunks > 1 && !bucketWorkersStarted)
+	{
+		bucketStartWorkers();
+	}
+	bucketJobFunc = &func;
+	bucketJobChunks = numChunks;
+	bucketJobNextChunk = 0;
+	// No worker is running a job at this point, so the ones we wake see the job set up above
+	const size_t numWoken = std::min<size_t>(bucketNumWorkers, numChunks > 0 ? numChunks - 1 : 0);
+	for (size_t i = 0; i < numWoken; ++i)
+	{
+		wzSemaphorePost(bucketJobStart);
+	}
+	bucketRunJobChunks();
+	for (size_t i = 0; i < numWoken; ++i)
+	{
+		wzSemaphoreWait(bucketJobDone);
+	}
+	bucketJobFunc = nullptr;
+}
+
+/* stop the render list worker threads */
+void bucketShutdown()
+{
+	bucketWorkersStarted = false;
+	if (bucketNumWorkers == 0)
+	{
+		return;
+	}
+	bucketWorkersQuit = true;
+	for (unsigned i = 0; i < bucketNumWorkers; ++i)
+	{
+		wzSemaphorePost(bucketJobStart);
+	}
+	for (unsigned i = 0; i < bucketNumWorkers; ++i)
+	{
+		wzThreadJoin(bucketWorkers[i]);
+	}
+	wzSemaphoreDestroy(bucketJobStart);
+	wzSemaphoreDestroy(bucketJobDone);
+	bucketJobStart = nullptr;
+	bucketJobDone = nullptr;
+	bucketNumWorkers = 0;
+}
 
 static SDWORD bucketCalculateZ(RENDER_TYPE objectType, void *pObject, const glm::mat4 &perspectiveViewMatrix)
 {
@@ -308,23 +473,15 @@ static SDWORD bucketCalculateZ(RENDER_TYPE objectType, void *pObject, const glm:
 	return z;
 }
 
-/* add an object to the current render list */
-void bucketAddTypeToList(RENDER_TYPE objectType, void *pObject, const glm::mat4 &perspectiveViewMatrix)
+/** Fills in the render list tag of an object, returns false if the object has been clipped. Only reads the object. */
+static bool bucketMakeTag(RENDER_TYPE objectType, void *pObject, const glm::mat4 &perspectiveViewMatrix, BUCKET_TAG &newTag)
 {
-	const iIMDShape *pie;
-	BUCKET_TAG	newTag;
+	const iIMDShape *pie = nullptr;
 	int32_t		z = bucketCalculateZ(objectType, pObject, perspectiveViewMatrix);
 
 	if (z < 0)
 	{
-		/* Object will not be render - has been clipped! */
-		if (objectType == RENDER_DROID || objectType == RENDER_STRUCTURE)
-		{
-			/* Won't draw selection boxes */
-			((BASE_OBJECT *)pObject)->sDisplay.frameNumber = 0;
-		}
-
-		return;
+		return false;
 	}
 
 	switch (objectType)
@@ -345,6 +502,7 @@ void bucketAddTypeToList(RENDER_TYPE objectType, void *pObject, const glm::mat4
 			break;
 
 		default:
+			pie = ((EFFECT *)pObject)->imd;
 			z = INT32_MAX - 42;
 			break;
 		}
@@ -377,17 +535,115 @@ void bucketAddTypeToList(RENDER_TYPE objectType, void *pObject, const glm::mat4
 	//put the object data into the tag
 	newTag.objectType = objectType;
 	newTag.pObject = pObject;
-	newTag.actualZ = z;
+	newTag.sortKey = bucketSortKey(z, objectType, pie);
+	return true;
+}
+
+static void bucketObjectClipped(RENDER_TYPE objectType, void *pObject)
+{
+	/* Object will not be render - has been clipped! */
+	if (objectType == RENDER_DROID || objectType == RENDER_STRUCTURE)
+	{
+		/* Won't draw selection boxes */
+		((BASE_OBJECT *)pObject)->sDisplay.frameNumber = 0;
+	}
+}
+
+/* add an object to the current render list */
+void bucketAddTypeToList(RENDER_TYPE objectType, void *pObject, const glm::mat4 &perspectiveViewMatrix)
+{
+	BUCKET_TAG	newTag;
+
+	if (!bucketMakeTag(objectType, pObject, perspectiveViewMatrix, newTag))
+	{
+		bucketObjectClipped(objectType, pObject);
+		return;
+	}
 
 	//add tag to bucketArray
 	bucketArray.push_back(newTag);
 }
 
+/* add objects of one type to the current render list, in the same order as adding them one at a time would */
+void bucketAddTypesToList(RENDER_TYPE objectType, const std::vector<void *> &objects, const glm::mat4 &perspectiveViewMatrix)
+{
+	WZ_PROFILE_SCOPE(bucketAddTypesToList);
+	// One bucket per chunk, so merging them in chunk order gives the same list as a serial walk
+	static std::vector<std::vector<BUCKET_TAG>> chunkTags;
+	static std::vector<std::vector<void *>> chunkClipped;
+	const size_t numChunks = (objects.size() + BUCKET_CHUNK_SIZE - 1) / BUCKET_CHUNK_SIZE;
+	if (chunkTags.size() < numChunks)
+	{
+		chunkTags.resize(numChunks);
+		chunkClipped.resize(numChunks);
+	}
+
+	bucketParallelChunks(objects.size(), [&](size_t chunk) {
+		std::vector<BUCKET_TAG> &tags = chunkTags[chunk];
+		std::vector<void *> &clipped = chunkClipped[chunk];
+		tags.clear();
+		clipped.clear();
+		const size_t end = std::min(objects.size(), (chunk + 1) * BUCKET_CHUNK_SIZE);
+		for (size_t i = chunk * BUCKET_CHUNK_SIZE; i < end; ++i)
+		{
+			BUCKET_TAG newTag;
+			if (bucketMakeTag(objectType, objects[i], perspectiveViewMatrix, newTag))
+			{
+				tags.push_back(newTag);
+			}
+			else
+			{
+				clipped.push_back(objects[i]);
+			}
+		}
+	});
+
+	for (size_t chunk = 0; chunk < numChunks; ++chunk)
+	{
+		bucketArray.insert(bucketArray.end(), chunkTags[chunk].begin(), chunkTags[chunk].end());
+		for (void *pObject : chunkClipped[chunk])
+		{
+			bucketObjectClipped(objectType, pObject);
+		}
+	}
+}
+
+/* remove the objects that are not worth rendering from the list, keeping the order of the rest */
+void bucketCullObjects(std::vector<BASE_OBJECT *> &objects, bool (*isVisible)(BASE_OBJECT *psObj))
+{
+	WZ_PROFILE_SCOPE(bucketCullObjects);
+	static std::vector<std::vector<BASE_OBJECT *>> chunkVisible;
+	const size_t numChunks = (objects.size() + BUCKET_CHUNK_SIZE - 1) / BUCKET_CHUNK_SIZE;
+	if (chunkVisible.size() < numChunks)
+	{
+		chunkVisible.resize(numChunks);
+	}
+
+	bucketParallelChunks(objects.size(), [&](size_t chunk) {
+		std::vector<BASE_OBJECT *> &visible = chunkVisible[chunk];
+		visible.clear();
+		const size_t end = std::min(objects.size(), (chunk + 1) * BUCKET_CHUNK_SIZE);
+		for (size_t i = chunk * BUCKET_CHUNK_SIZE; i < end; ++i)
+		{
+			if (isVisible(objects[i]))
+			{
+				visible.push_back(objects[i]);
+			}
+		}
+	});
+
+	objects.clear();
+	for (size_t chunk = 0; chunk < numChunks; ++chunk)
+	{
+		objects.insert(objects.end(), chunkVisible[chunk].begin(), chunkVisible[chunk].end());
+	}
+}
+
 /* render Objects in list */
 void bucketRenderCurrentList(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
 	WZ_PROFILE_SCOPE(bucketRenderCurrentList);
-	std::sort(bucketArray.begin(), bucketArray.end());
+	bucketRadixSort(bucketArray);
 
 	for (auto thisTag = bucketArray.cbegin(); thisTag != bucketArray.cend(); ++thisTag)
 	{
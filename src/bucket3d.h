@@ -21,6 +21,10 @@
 #ifndef __INCLUDED_SRC_BUCKET3D_H__
 #define __INCLUDED_SRC_BUCKET3D_H__
 
+#include <vector>
+
+struct BASE_OBJECT;
+
 enum RENDER_TYPE
 {
 	RENDER_DROID,
@@ -38,7 +42,16 @@ enum RENDER_TYPE
 /* add an object to the current render list */
 void bucketAddTypeToList(RENDER_TYPE objectType, void *object, const glm::mat4 &perspectiveViewMatrix);
 
+/* add objects of one type to the current render list, in the same order as adding them one at a time would */
+void bucketAddTypesToList(RENDER_TYPE objectType, const std::vector<void *> &objects, const glm::mat4 &perspectiveViewMatrix);
+
+/* remove the objects that are not worth rendering from the list, keeping the order of the rest (isVisible may run on several threads at once) */
+void bucketCullObjects(std::vector<BASE_OBJECT *> &objects, bool (*isVisible)(BASE_OBJECT *psObj));
+
 /* render Objects in list */
 void bucketRenderCurrentList(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix);
 
+/* stop the render list worker threads */
+void bucketShutdown();
+
 #endif // __INCLUDED_SRC_BUCKET3D_H__
@@ -38,6 +38,7 @@
 #include "keybind.h"
 #include "loadsave.h"
 #include "main.h"
+#include "forkserver.h"
 #include "modding.h"
 #include "multiplay.h"
 #include "version.h"
@@ -369,6 +370,9 @@ typedef enum
 	CLI_VIDEOURL,
 #endif
 	CLI_HOST_CONNECTION_PROVIDER,
+#if defined(WZ_OS_LINUX)
+	CLI_FORK_SERVER,
+#endif
 } CLI_OPTIONS;
 
 // Separate table that avoids *any* translated strings, to avoid any risk of gettext / libintl function calls
@@ -464,6 +468,9 @@ static const struct poptOption *getOptionsTable()
 		{ "videourl", POPT_ARG_STRING, CLI_VIDEOURL,   N_("Base URL for on-demand video downloads"), N_("Base video URL") },
 #endif
 		{ "host-connection-provider", POPT_ARG_STRING, CLI_HOST_CONNECTION_PROVIDER, N_("Specify connection provider type to use when hosting game sessions"), "[tcp]" },
+#if defined(WZ_OS_LINUX)
+		{ "fork-server", POPT_ARG_STRING, CLI_FORK_SERVER, N_("Load game data once, then fork a headless autohost for each request on the given unix socket (Linux only)"), N_("socket path") },
+#endif
 
 		// Terminating entry
 		{ nullptr, 0, 0,              nullptr,                                    nullptr },
@@ -542,7 +549,7 @@ bool ParseCommandLineDebugFlags(int argc, const char * const *argv)
 				qFatal("Missing debugfile filename?");
 			}
 			WzString debug_filename = token;
-			debug_register_callback(debug_callback_file, debug_callback_file_init, debug_callback_file_exit, &debug_filename); // note: by the time this function returns, all use of debug_filename has completed
+			debug_register_callback(debug_callback_file, debug_callback_file_init, debug_callback_file_exit, &debug_filename, true); // note: by the time this function returns, all use of debug_filename has completed
 			customDebugfile = true;
 			break;
 		}
@@ -1379,6 +1386,17 @@ bool ParseCommandLine(int argc, const char * const *argv)
 			war_setHostConnectionProvider(pt);
 			break;
 
+#if defined(WZ_OS_LINUX)
+		case CLI_FORK_SERVER:
+			token = poptGetOptArg(poptCon);
+			if (token == nullptr || strlen(token) == 0)
+			{
+				qFatal("Missing fork server socket path");
+			}
+			forkServerSetSocketPath(token);
+			break;
+#endif
+
 		} // switch (option)
 	} // while
 
@@ -1400,6 +1418,11 @@ const std::string &wz_skirmish_test()
 	return wz_test;
 }
 
+void setSkirmishTest(const std::string &test)
+{
+	wz_test = test;
+}
+
 void setAutoratingUrl(std::string url) {
 	wz_autoratingUrl = url;
 }
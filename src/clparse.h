@@ -38,6 +38,7 @@ bool ParseCommandLineDebugFlags(int argc, const char * const *argv);
 bool autogame_enabled();
 const std::string &saveandquit_enabled();
 const std::string &wz_skirmish_test();
+void setSkirmishTest(const std::string &test);
 void setAutoratingUrl(std::string url);
 std::string getAutoratingUrl();
 void setAutoratingEnable(bool e);
@@ -65,10 +65,13 @@ uint32_t	DataHash[DATA_MAXDATA] = {0};
 */
 static void hashBuffer(const uint8_t *pData, uint32_t size, uint32_t &crc)
 {
-	char nl = '\n';
+	// CRC the non-empty lines, each followed by a '\n' line ending. Consecutive lines that already
+	// end in a single '\n' are passed to the CRC in one go, straight from the buffer.
+	const char nl = '\n';
 	uint32_t i, j;
 	uint32_t lines = 0;
 	uint32_t bytes = 0;
+	uint32_t runStart = 0, runEnd = 0;  // Pending bytes, not CRCed yet.
 	for (i = 0; i < size; i = j + 1)
 	{
 		for (j = i; j < size && pData[j] != '\n' && pData[j] != '\r'; ++j)
@@ -76,13 +79,34 @@ static void hashBuffer(const uint8_t *pData, uint32_t size, uint32_t &crc)
 
 		if (i != j)  // CRC non-empty lines only.
 		{
-			crc = wz::crc_update(crc, pData + i, j - i);  // CRC the line.
-			crc = wz::crc_update(crc, &nl, 1);            // CRC the line ending.
+			if (i != runEnd)
+			{
+				// Skipped something since the last line, so flush the pending run.
+				if (runEnd > runStart)
+				{
+					crc = wz::crc_update(crc, pData + runStart, runEnd - runStart);
+				}
+				runStart = i;
+			}
+			if (j < size && pData[j] == '\n')
+			{
+				runEnd = j + 1;  // The line ending is already the one we want.
+			}
+			else
+			{
+				crc = wz::crc_update(crc, pData + runStart, j - runStart);  // CRC the line.
+				crc = wz::crc_update(crc, &nl, 1);                          // CRC the line ending.
+				runStart = runEnd = j + 1;
+			}
 
 			++lines;
 			bytes += j - i + 1;
 		}
 	}
+	if (runEnd > runStart)
+	{
+		crc = wz::crc_update(crc, pData + runStart, runEnd - runStart);
+	}
 	debug(LOG_NET, "The size of the old buffer (%u bytes - %d stripped), New buffer size of %u bytes, %u non-empty lines.", size, size - bytes, bytes, lines);
 }
 
@@ -676,40 +700,41 @@ struct RES_TYPE_MIN_FILE
 	const char *aType;                      ///< points to the string defining the type (e.g. SCRIPT) - NULL indicates end of list
 	RES_FILELOAD fileLoad;                  ///< routine to process the data for this type
 	RES_FREE release;                       ///< routine to release the data (NULL indicates none)
+	bool readsWithLoadFile;                 ///< fileLoad reads the file with loadFile() (so it can be read ahead)
 };
 
 static const RES_TYPE_MIN_FILE FileResourceTypes[] =
 {
-	{"SFEAT", bufferSFEATLoad, dataSFEATRelease},                  //feature stats file
-	{"STEMPL", bufferSTEMPLLoad, dataSTEMPLRelease},               //template and associated files
-	{"WAV", dataAudioLoad, (RES_FREE)sound_ReleaseTrack},
-	{"SWEAPON", bufferSWEAPONLoad, dataReleaseStats},
-	{"SBPIMD", bufferSBPIMDLoad, dataReleaseStats},
-	{"SBRAIN", bufferSBRAINLoad, dataReleaseStats},
-	{"SSENSOR", bufferSSENSORLoad, dataReleaseStats},
-	{"SECM", bufferSECMLoad, dataReleaseStats},
-	{"SREPAIR", bufferSREPAIRLoad, dataReleaseStats},
-	{"SCONSTR", bufferSCONSTRLoad, dataReleaseStats},
-	{"SPROP", bufferSPROPLoad, dataReleaseStats},
-	{"SPROPTYPES", bufferSPROPTYPESLoad, dataReleaseStats},
-	{"STERRTABLE", bufferSTERRTABLELoad, dataReleaseStats},
-	{"SBODY", bufferSBODYLoad, dataReleaseStats},
-	{"SWEAPMOD", bufferSWEAPMODLoad, dataReleaseStats},
-	{"SPROPSND", bufferSPROPSNDLoad, dataReleaseStats},
-	{"AUDIOCFG", dataAudioCfgLoad, nullptr},
-	{"IMGPAGE", dataImageLoad, dataImageRelease},
-	{"TERTILES", dataTERTILESLoad, nullptr},
-	{"IMG", dataIMGLoad, dataIMGRelease},
-	{"TEXPAGE", nullptr, nullptr}, // ignored
-	{"TCMASK", nullptr, nullptr}, // ignored
-	{"STR_RES", dataStrResLoad, dataStrResRelease},
-	{"RESEARCHMSG", dataResearchMsgLoad, dataSMSGRelease },
-	{"SSTRMOD", bufferSSTRMODLoad, nullptr},
-	{"JAVASCRIPT", jsLoad, nullptr},
-	{"SSTRUCT", bufferSSTRUCTLoad, dataSSTRUCTRelease},            //structure stats and associated files
-	{"RESCH", bufferRESCHLoad, dataRESCHRelease},                  //research stats files
-	{"PROX", dataProximityMsgLoad, dataSMSGRelease },
-	{"FLIC", dataFlicMsgLoad, dataSMSGRelease },
+	{"SFEAT", bufferSFEATLoad, dataSFEATRelease, true},                  //feature stats file
+	{"STEMPL", bufferSTEMPLLoad, dataSTEMPLRelease, true},               //template and associated files
+	{"WAV", dataAudioLoad, (RES_FREE)sound_ReleaseTrack, false},
+	{"SWEAPON", bufferSWEAPONLoad, dataReleaseStats, true},
+	{"SBPIMD", bufferSBPIMDLoad, dataReleaseStats, true},
+	{"SBRAIN", bufferSBRAINLoad, dataReleaseStats, true},
+	{"SSENSOR", bufferSSENSORLoad, dataReleaseStats, true},
+	{"SECM", bufferSECMLoad, dataReleaseStats, true},
+	{"SREPAIR", bufferSREPAIRLoad, dataReleaseStats, true},
+	{"SCONSTR", bufferSCONSTRLoad, dataReleaseStats, true},
+	{"SPROP", bufferSPROPLoad, dataReleaseStats, true},
+	{"SPROPTYPES", bufferSPROPTYPESLoad, dataReleaseStats, true},
+	{"STERRTABLE", bufferSTERRTABLELoad, dataReleaseStats, true},
+	{"SBODY", bufferSBODYLoad, dataReleaseStats, true},
+	{"SWEAPMOD", bufferSWEAPMODLoad, dataReleaseStats, true},
+	{"SPROPSND", bufferSPROPSNDLoad, dataReleaseStats, true},
+	{"AUDIOCFG", dataAudioCfgLoad, nullptr, true},
+	{"IMGPAGE", dataImageLoad, dataImageRelease, false},
+	{"TERTILES", dataTERTILESLoad, nullptr, false},
+	{"IMG", dataIMGLoad, dataIMGRelease, true},
+	{"TEXPAGE", nullptr, nullptr, false}, // ignored
+	{"TCMASK", nullptr, nullptr, false}, // ignored
+	{"STR_RES", dataStrResLoad, dataStrResRelease, false},
+	{"RESEARCHMSG", dataResearchMsgLoad, dataSMSGRelease, true },
+	{"SSTRMOD", bufferSSTRMODLoad, nullptr, true},
+	{"JAVASCRIPT", jsLoad, nullptr, true},
+	{"SSTRUCT", bufferSSTRUCTLoad, dataSSTRUCTRelease, true},            //structure stats and associated files
+	{"RESCH", bufferRESCHLoad, dataRESCHRelease, true},                  //research stats files
+	{"PROX", dataProximityMsgLoad, dataSMSGRelease, true },
+	{"FLIC", dataFlicMsgLoad, dataSMSGRelease, true },
 };
 
 /* Pass all the data loading functions to the framework library */
@@ -743,7 +768,7 @@ bool dataInitLoadFuncs()
 
 		for (CurrentType = FileResourceTypes; CurrentType != EndType; ++CurrentType)
 		{
-			if (!resAddFileLoad(CurrentType->aType, CurrentType->fileLoad, CurrentType->release))
+			if (!resAddFileLoad(CurrentType->aType, CurrentType->fileLoad, CurrentType->release, CurrentType->readsWithLoadFile))
 			{
 				return false; // error whilst adding a file load
 			}
@@ -1647,6 +1647,7 @@ void shutdown3DView_FullReset()
 	// Only call "reset" (which also resets BatchedMultiRectRenderer and actually frees GPU buffers)
 	// in this function, which is called from stageTwoShutdown (as opposed to stageThreeShutdown, which is called from levReleaseMissionData)...
 	batchedObjectStatusRenderer.reset();
+	bucketShutdown();
 
 	delete pScreenTriangleVBO;
 	pScreenTriangleVBO = nullptr;
@@ -1784,6 +1785,21 @@ bool clipStructureOnScreen(STRUCTURE *psStructure)
 {
 	StructureBounds b = getStructureBounds(psStructure);
 	assert(b.size.x != 0 && b.size.y != 0);
+
+	// Reject structures whose whole footprint lies outside the clipXY() window up front,
+	// instead of testing each of the (size + 2)^2 tiles individually (most structures on
+	// the map are off-screen, so this is the common case)
+	const int minX = world_coord(b.map.x) - playerPos.p.x;
+	const int maxX = world_coord(b.map.x + b.size.x + 1) - playerPos.p.x;
+	const int minY = world_coord(b.map.y) - playerPos.p.z;
+	const int maxY = world_coord(b.map.y + b.size.y + 1) - playerPos.p.z;
+	const int limitX = world_coord(visibleTiles.x / 2 + 2);
+	const int limitY = world_coord(visibleTiles.y / 2 + 2);
+	if (maxX <= -limitX || minX >= limitX || maxY <= -limitY || minY >= limitY)
+	{
+		return false;
+	}
+
 	for (int breadth = 0; breadth < b.size.y + 2; ++breadth) // +2 to make room for shadows on the terrain
 	{
 		for (int width = 0; width < b.size.x + 2; ++width)
@@ -1823,6 +1839,8 @@ static void	calcFlagPosScreenCoords(SDWORD *pX, SDWORD *pY, SDWORD *pR, const gl
 static void display3DProjectiles(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
 	WZ_PROFILE_SCOPE(display3DProjectiles);
+	static std::vector<void *> bucketProjectiles;
+	bucketProjectiles.clear();
 	PROJECTILE *psObj = proj_GetFirst();
 	while (psObj != nullptr)
 	{
@@ -1842,7 +1860,7 @@ static void display3DProjectiles(const glm::mat4 &viewMatrix, const glm::mat4 &p
 			    psObj->psWStats->weaponSubClass == WSC_ENERGY ||
 			    psObj->psWStats->weaponSubClass == WSC_EMP)
 			{
-				bucketAddTypeToList(RENDER_PROJECTILE, psObj, perspectiveViewMatrix);
+				bucketProjectiles.push_back(psObj);
 			}
 			else
 			{
@@ -1852,6 +1870,7 @@ static void display3DProjectiles(const glm::mat4 &viewMatrix, const glm::mat4 &p
 
 		psObj = proj_GetNext();
 	}
+	bucketAddTypesToList(RENDER_PROJECTILE, bucketProjectiles, perspectiveViewMatrix);
 }	/* end of function display3DProjectiles */
 
 /// Draw a projectile to the screen
@@ -1992,10 +2011,17 @@ void	renderProjectile(PROJECTILE *psCurr, const glm::mat4 &viewMatrix, const glm
 	}
 }
 
+static bool isStructureOnScreen(BASE_OBJECT *psObj)
+{
+	return clipStructureOnScreen(castStructure(psObj));
+}
+
 /// Draw the buildings
 static void displayStaticObjects(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
 	WZ_PROFILE_SCOPE(displayStaticObjects);
+	static std::vector<BASE_OBJECT *> structures;
+	structures.clear();
 	// to solve the flickering edges of baseplates
 //	pie_SetDepthOffset(-1.0f);
 
@@ -2010,20 +2036,11 @@ static void displayStaticObjects(const glm::mat4 &viewMatrix, const glm::mat4 &p
 			{
 				continue;
 			}
-			STRUCTURE *psStructure = castStructure(obj);
-
-			if (!clipStructureOnScreen(psStructure))
-			{
-				continue;
-			}
-
-			renderStructure(psStructure, viewMatrix, perspectiveViewMatrix);
+			structures.push_back(obj);
 		}
 	}
 
 	// Walk through destroyed objects.
-
-	/* Now go all buildings for that player */
 	for (BASE_OBJECT* obj : psDestroyedObj)
 	{
 		/* Worth rendering the structure? */
@@ -2031,14 +2048,14 @@ static void displayStaticObjects(const glm::mat4 &viewMatrix, const glm::mat4 &p
 		{
 			continue;
 		}
-		STRUCTURE* psStructure = castStructure(obj);
-
-		if (!clipStructureOnScreen(psStructure))
-		{
-			continue;
-		}
+		structures.push_back(obj);
+	}
 
-		renderStructure(psStructure, viewMatrix, perspectiveViewMatrix);
+	// Clip on the worker threads, then render in list order on this one
+	bucketCullObjects(structures, isStructureOnScreen);
+	for (BASE_OBJECT *obj : structures)
+	{
+		renderStructure(castStructure(obj), viewMatrix, perspectiveViewMatrix);
 	}
 
 //	pie_SetDepthOffset(0.0f);
@@ -2274,21 +2291,26 @@ static void displayDelivPoints(const glm::mat4& viewMatrix, const glm::mat4 &per
 	}
 }
 
+static bool isFeatureOnScreen(BASE_OBJECT *psObj)
+{
+	return clipXY(psObj->pos.x, psObj->pos.y);
+}
+
 /// Draw the features
 static void displayFeatures(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
 	WZ_PROFILE_SCOPE(displayFeatures);
+	static std::vector<BASE_OBJECT *> features;
+	features.clear();
 	// player can only be 0 for the features.
 
 	/* Go through all the features */
 	for (BASE_OBJECT* obj : apsFeatureLists[0])
 	{
 		if (obj->type == OBJ_FEATURE
-			&& (obj->died == 0 || obj->died > graphicsTime)
-			&& clipXY(obj->pos.x, obj->pos.y))
+			&& (obj->died == 0 || obj->died > graphicsTime))
 		{
-			FEATURE* psFeature = castFeature(obj);
-			renderFeature(psFeature, viewMatrix, perspectiveViewMatrix);
+			features.push_back(obj);
 		}
 	}
 
@@ -2298,13 +2320,17 @@ static void displayFeatures(const glm::mat4 &viewMatrix, const glm::mat4 &perspe
 	for (BASE_OBJECT* obj : psDestroyedObj)
 	{
 		if (obj->type == OBJ_FEATURE
-			&& (obj->died == 0 || obj->died > graphicsTime)
-			&& clipXY(obj->pos.x, obj->pos.y))
+			&& (obj->died == 0 || obj->died > graphicsTime))
 		{
-			FEATURE* psFeature = castFeature(obj);
-			renderFeature(psFeature, viewMatrix, perspectiveViewMatrix);
+			features.push_back(obj);
 		}
 	}
+
+	bucketCullObjects(features, isFeatureOnScreen);
+	for (BASE_OBJECT *obj : features)
+	{
+		renderFeature(castFeature(obj), viewMatrix, perspectiveViewMatrix);
+	}
 }
 
 /// Draw the Proximity messages for the *SELECTED PLAYER ONLY*
@@ -2350,26 +2376,28 @@ static void displayProximityMsgs(const glm::mat4& viewMatrix, const glm::mat4 &p
 	}
 }
 
+static bool isDroidOnScreen(BASE_OBJECT *psObj)
+{
+	/* No point in adding it if you can't see it? */
+	return quickClipXYToMaximumTilesFromCurrentPosition(psObj->pos.x, psObj->pos.y) && psObj->visibleForLocalDisplay();
+}
+
 /// Draw the droids
 static void displayDynamicObjects(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
 	WZ_PROFILE_SCOPE(displayDynamicObjects);
+	static std::vector<BASE_OBJECT *> droids;
+	droids.clear();
 	/* Need to go through all the droid lists */
 	for (unsigned player = 0; player < MAX_PLAYERS; ++player)
 	{
 		for (DROID* psDroid : apsDroidLists[player])
 		{
-			if (!psDroid || (psDroid->died != 0 && psDroid->died < graphicsTime)
-			    || !quickClipXYToMaximumTilesFromCurrentPosition(psDroid->pos.x, psDroid->pos.y))
+			if (!psDroid || (psDroid->died != 0 && psDroid->died < graphicsTime))
 			{
 				continue;
 			}
-
-			/* No point in adding it if you can't see it? */
-			if (psDroid->visibleForLocalDisplay())
-			{
-				displayComponentObject(psDroid, viewMatrix, perspectiveViewMatrix);
-			}
+			droids.push_back(psDroid);
 		}
 	}
 
@@ -2377,17 +2405,17 @@ static void displayDynamicObjects(const glm::mat4 &viewMatrix, const glm::mat4 &
 	for (const auto& obj : psDestroyedObj)
 	{
 		DROID* psDroid = castDroid(obj);
-		if (!psDroid || (obj->died != 0 && obj->died < graphicsTime)
-			|| !quickClipXYToMaximumTilesFromCurrentPosition(obj->pos.x, obj->pos.y))
+		if (!psDroid || (obj->died != 0 && obj->died < graphicsTime))
 		{
 			continue;
 		}
+		droids.push_back(psDroid);
+	}
 
-		/* No point in adding it if you can't see it? */
-		if (psDroid->visibleForLocalDisplay())
-		{
-			displayComponentObject(psDroid, viewMatrix, perspectiveViewMatrix);
-		}
+	bucketCullObjects(droids, isDroidOnScreen);
+	for (BASE_OBJECT *obj : droids)
+	{
+		displayComponentObject(castDroid(obj), viewMatrix, perspectiveViewMatrix);
 	}
 }
 
@@ -99,6 +99,55 @@ static void groupConsoleInformOfRemoval();
 static void droidUpdateDroidSelfRepair(DROID *psRepairDroid);
 static UDWORD calcDroidBaseBody(DROID *psDroid);
 
+/// Components that determine a droid's upgrade-derived stats (together with its owner's upgrades)
+struct DroidUpgradeStatsKey
+{
+	uint8_t parts[DROID_MAXCOMP];
+	uint32_t weaps[MAX_WEAPONS];
+	uint32_t numWeaps;  ///< calcBody() only counts the first numWeaps weapons
+	uint32_t weight;
+
+	bool operator ==(const DroidUpgradeStatsKey &other) const
+	{
+		return memcmp(parts, other.parts, sizeof(parts)) == 0 && memcmp(weaps, other.weaps, sizeof(weaps)) == 0 && numWeaps == other.numWeaps && weight == other.weight;
+	}
+};
+
+struct DroidUpgradeStatsKeyHash
+{
+	size_t operator()(const DroidUpgradeStatsKey &key) const
+	{
+		size_t hash = key.weight;
+		for (uint8_t part : key.parts)
+		{
+			hash = hash * 31 + part;
+		}
+		for (uint32_t weap : key.weaps)
+		{
+			hash = hash * 31 + weap;
+		}
+		hash = hash * 31 + key.numWeaps;
+		return hash;
+	}
+};
+
+struct DroidUpgradeStats
+{
+	uint32_t originalBody;
+	uint32_t baseSpeed;
+	uint32_t generation;  ///< Value of droidUpgradeGeneration[player] these were calculated for
+};
+
+/// Applying an upgrade flags every droid of the player for droidBodyUpgrade(); droids with the same components share the result
+static std::unordered_map<DroidUpgradeStatsKey, DroidUpgradeStats, DroidUpgradeStatsKeyHash> droidUpgradeStatsCache[MAX_PLAYERS];
+static uint32_t droidUpgradeGeneration[MAX_PLAYERS];
+
+void droidUpgradesChanged(int player)
+{
+	ASSERT_OR_RETURN(, player >= 0 && player < MAX_PLAYERS, "Invalid player: %d", player);
+	++droidUpgradeGeneration[player];
+}
+
 int getTopExperience(int player)
 {
 	if (recycled_experience[player].size() == 0)
@@ -137,17 +186,58 @@ void cancelBuild(DROID *psDroid)
 	}
 }
 
+static DroidUpgradeStats calcDroidUpgradeStats(DROID *psDroid)
+{
+	DroidUpgradeStats stats;
+	stats.originalBody = calcDroidBaseBody(psDroid);
+	DROID_TEMPLATE sTemplate;
+	templateSetParts(psDroid, &sTemplate);
+	stats.baseSpeed = calcDroidBaseSpeed(&sTemplate, psDroid->weight, psDroid->player);
+	stats.generation = droidUpgradeGeneration[psDroid->player];
+	return stats;
+}
+
+static const DroidUpgradeStats &droidUpgradeStats(DROID *psDroid)
+{
+	DroidUpgradeStatsKey key;
+	memcpy(key.parts, psDroid->asBits, sizeof(key.parts));
+	for (int i = 0; i < MAX_WEAPONS; ++i)
+	{
+		key.weaps[i] = psDroid->asWeaps[i].nStat;
+	}
+	key.numWeaps = psDroid->numWeaps;
+	key.weight = psDroid->weight;
+
+	auto it = droidUpgradeStatsCache[psDroid->player].find(key);
+	if (it == droidUpgradeStatsCache[psDroid->player].end())
+	{
+		it = droidUpgradeStatsCache[psDroid->player].emplace(key, calcDroidUpgradeStats(psDroid)).first;
+	}
+	else if (it->second.generation != droidUpgradeGeneration[psDroid->player])
+	{
+		it->second = calcDroidUpgradeStats(psDroid);
+	}
+#ifdef DEBUG
+	else
+	{
+		const DroidUpgradeStats recalculated = calcDroidUpgradeStats(psDroid);
+		ASSERT(recalculated.originalBody == it->second.originalBody && recalculated.baseSpeed == it->second.baseSpeed, "Stale upgrade stats for droid %" PRIu32 " (player %d)", psDroid->id, (int)psDroid->player);
+	}
+#endif
+	return it->second;
+}
+
 static void droidBodyUpgrade(DROID *psDroid)
 {
+	ASSERT_OR_RETURN(, psDroid->player < MAX_PLAYERS, "Invalid player: %d", (int)psDroid->player);
+	const DroidUpgradeStats &stats = droidUpgradeStats(psDroid);
 	const int factor = 10000; // use big numbers to scare away rounding errors
 	int prev = psDroid->originalBody;
-	psDroid->originalBody = calcDroidBaseBody(psDroid);
+	psDroid->originalBody = stats.originalBody;
 	int increase = psDroid->originalBody * factor / prev;
 	psDroid->body = MIN(psDroid->originalBody, (psDroid->body * increase) / factor + 1);
-	DROID_TEMPLATE sTemplate;
-	templateSetParts(psDroid, &sTemplate);
 	// update engine too
-	psDroid->baseSpeed = calcDroidBaseSpeed(&sTemplate, psDroid->weight, psDroid->player);
+	psDroid->baseSpeed = stats.baseSpeed;
 	if (psDroid->isTransporter())
 	{
 		for (DROID *psCurr : psDroid->psGroup->psList)
@@ -166,6 +256,8 @@ bool droidInit()
 	for (int i = 0; i < MAX_PLAYERS; i++)
 	{
 		recycled_experience[i] = std::priority_queue <int>(); // clear it
+		droidUpgradeStatsCache[i].clear();
+		++droidUpgradeGeneration[i];
 	}
 	psLastDroidHit = nullptr;
 
@@ -100,6 +100,9 @@ UDWORD calcDroidPoints(const DROID *psDroid);
 /* Calculate the body points of a droid from it's template */
 UDWORD calcTemplateBody(const DROID_TEMPLATE *psTemplate, UBYTE player);
 
+/* Must be called whenever an upgrade that affects droid body points or speed changes for the player */
+void droidUpgradesChanged(int player);
+
 /* Calculate the base speed of a droid from it's template */
 UDWORD calcDroidBaseSpeed(const DROID_TEMPLATE *psTemplate, UDWORD weight, UBYTE player);
 
@@ -185,7 +185,7 @@ static bool updateDestruction(EFFECT *psEffect, LightingData& lightData);
 static bool updateFire(EFFECT *psEffect, LightingData& lightData);
 static bool updateSatLaser(EFFECT *psEffect, LightingData& lightData);
 static bool updateFirework(EFFECT *psEffect);
-static bool updateEffect(EFFECT *psEffect, LightingData& lightData);	// MASTER function
+static bool updateEffect(EFFECT *psEffect, LightingData& lightData, bool paused);	// MASTER function
 
 // ----------------------------------------------------------------------------------------
 // ---- The render functions - every group type of effect has a distinct one
@@ -243,6 +243,21 @@ static glm::mat4 positionEffect(const EFFECT *psEffect)
 	return glm::translate(dv);
 }
 
+/** Rotation that makes an effect face the viewer. Identical for all effects in a frame, so only recalculate it when the camera turns. */
+static const glm::mat4 &effectFacingMatrix()
+{
+	static glm::mat4 facingMatrix(1.f);
+	static Vector3i facingRotation(0, 0, 0);
+	static bool facingMatrixValid = false;
+	if (!facingMatrixValid || facingRotation.x != playerPos.r.x || facingRotation.y != playerPos.r.y)
+	{
+		facingMatrix = glm::rotate(UNDEG(-playerPos.r.y), glm::vec3(0.f, 1.f, 0.f)) * glm::rotate(UNDEG(-playerPos.r.x), glm::vec3(1.f, 0.f, 0.f));
+		facingRotation = playerPos.r;
+		facingMatrixValid = true;
+	}
+	return facingMatrix;
+}
+
 void effectSetLandLightSpec(LAND_LIGHT_SPEC spec)
 {
 	ellSpec = spec;
@@ -473,34 +488,56 @@ void addEffect(const Vector3i *pos, EFFECT_GROUP group, EFFECT_TYPE type, bool s
 }
 
 
+/** Whether effects of this group draw anything themselves (see renderEffect()) */
+static inline bool effectHasVisual(EFFECT_GROUP group)
+{
+	switch (group)
+	{
+	case EFFECT_FIRE:
+	case EFFECT_SAT_LASER:
+	case EFFECT_FREED:
+		return false;
+	default:
+		return true;
+	}
+}
+
 /* Calls all the update functions for each different currently active effect */
 void processEffects(const glm::mat4 &perspectiveViewMatrix, LightingData& lightData)
 {
 	WZ_PROFILE_SCOPE(processEffects);
+	const bool paused = gamePaused();
+	static std::vector<void *> visibleEffects;
+	visibleEffects.clear();
 	for (auto it = gActiveEffects.begin(); it != gActiveEffects.end(); ++it)
 	{
 		EFFECT& e = *it;
 
 		if (e.birthTime <= graphicsTime)  // Don't process, if it doesn't exist yet
 		{
-			if (!updateEffect(&e, lightData))
+			if (!updateEffect(&e, lightData, paused))
 			{
 				gActiveEffects.erase(it);
 				continue;
 			}
-			if (e.group != EFFECT_FREED && clipXY(static_cast<SDWORD>(e.position.x), static_cast<SDWORD>(e.position.z)))
+			if (!effectHasVisual(e.group))
+			{
+				continue; // only spawns other effects / lights, nothing to project and sort
+			}
+			if (clipXY(static_cast<SDWORD>(e.position.x), static_cast<SDWORD>(e.position.z)))
 			{
-				bucketAddTypeToList(RENDER_EFFECT, &e, perspectiveViewMatrix);
+				visibleEffects.push_back(&e);
 			}
 		}
 	}
+	bucketAddTypesToList(RENDER_EFFECT, visibleEffects, perspectiveViewMatrix);
 
 	/* Add any structure effects */
 	effectStructureUpdates();
 }
 
 /* The general update function for all effects - calls a specific one for each. Returns false if effect should be deleted. */
-static bool updateEffect(EFFECT *psEffect, LightingData& lightData)
+static bool updateEffect(EFFECT *psEffect, LightingData& lightData, bool paused)
 {
 	/* What type of effect are we dealing with? */
 	switch (psEffect->group)
@@ -508,55 +545,55 @@ static bool updateEffect(EFFECT *psEffect, LightingData& lightData)
 	case EFFECT_EXPLOSION:
 		return updateExplosion(psEffect, lightData);
 	case EFFECT_WAYPOINT:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateWaypoint(psEffect);
 		}
 		return true;
 	case EFFECT_CONSTRUCTION:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateConstruction(psEffect);
 		}
 		return true;
 	case EFFECT_SMOKE:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updatePolySmoke(psEffect);
 		}
 		return true;
 	case EFFECT_GRAVITON:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateGraviton(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_BLOOD:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateBlood(psEffect);
 		}
 		return true;
 	case EFFECT_DESTRUCTION:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateDestruction(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_FIRE:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateFire(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_SAT_LASER:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateSatLaser(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_FIREWORK:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateFirework(psEffect);
 		}
@@ -1457,8 +1494,7 @@ static void renderFirework(const EFFECT *psEffect, const glm::mat4 &viewMatrix)
 	}
 
 	glm::mat4 modelMatrix = positionEffect(psEffect);
-	modelMatrix *= glm::rotate(UNDEG(-playerPos.r.y), glm::vec3(0.f, 1.f, 0.f)) * glm::rotate(UNDEG(-playerPos.r.x), glm::vec3(1.f, 0.f, 0.f))
-	               * glm::scale(glm::vec3(psEffect->size / 100.f));
+	modelMatrix *= effectFacingMatrix() * glm::scale(glm::vec3(psEffect->size / 100.f));
 
 	pie_Draw3DShape(psEffect->imd, psEffect->frameNumber, 0, WZCOL_WHITE, pie_ADDITIVE | pie_NODEPTHWRITE, EFFECT_EXPLOSION_ADDITIVE, modelMatrix, viewMatrix);
 }
@@ -1467,8 +1503,7 @@ static void renderFirework(const EFFECT *psEffect, const glm::mat4 &viewMatrix)
 static void renderBloodEffect(const EFFECT *psEffect, const glm::mat4 &viewMatrix)
 {
 	glm::mat4 modelMatrix = positionEffect(psEffect);
-	modelMatrix *= glm::rotate(UNDEG(-playerPos.r.y), glm::vec3(0.f, 1.f, 0.f)) * glm::rotate(UNDEG(-playerPos.r.x), glm::vec3(1.f, 0.f, 0.f))
-	               * glm::scale(glm::vec3(psEffect->size / 100.f));
+	modelMatrix *= effectFacingMatrix() * glm::scale(glm::vec3(psEffect->size / 100.f));
 
 	pie_Draw3DShape(getDisplayImdFromIndex(MI_BLOOD), psEffect->frameNumber, 0, WZCOL_WHITE, pie_TRANSLUCENT | pie_NODEPTHWRITE, EFFECT_BLOOD_TRANSPARENCY, modelMatrix, viewMatrix);
 }
@@ -1556,9 +1591,7 @@ static void renderExplosionEffect(const EFFECT *psEffect, const glm::mat4 &viewM
 	{
 		/* Always face the viewer! */
 		// TODO This only faces towards the viewer, if the effect is in the middle of the screen... It draws the effect parallel with the screens near/far planes.
-		modelMatrix *=
-			glm::rotate(UNDEG(-playerPos.r.y), glm::vec3(0.f, 1.f, 0.f)) *
-			glm::rotate(UNDEG(-playerPos.r.x), glm::vec3(1.f, 0.f, 0.f));
+		modelMatrix *= effectFacingMatrix();
 	}
 
 	/* Tesla explosions diminish in size */
@@ -1642,9 +1675,7 @@ static void renderConstructionEffect(const EFFECT *psEffect, const glm::mat4 &vi
 	/* Bit in comments doesn't quite work yet? */
 	if (TEST_FACING(psEffect))
 	{
-		modelMatrix *=
-			glm::rotate(UNDEG(-playerPos.r.y), glm::vec3(0.f, 1.f, 0.f)) *
-			glm::rotate(UNDEG(-playerPos.r.x), glm::vec3(1.f, 0.f, 0.f));
+		modelMatrix *= effectFacingMatrix();
 	}
 
 	/* Scale size according to age */
@@ -1686,8 +1717,7 @@ static void renderSmokeEffect(const EFFECT *psEffect, const glm::mat4 &viewMatri
 	if (TEST_FACING(psEffect))
 	{
 		/* Always face the viewer! */
-		modelMatrix *= glm::rotate(UNDEG(-playerPos.r.y), glm::vec3(0.f, 1.f, 0.f)) *
-			glm::rotate(UNDEG(-playerPos.r.x), glm::vec3(1.f, 0.f, 0.f));
+		modelMatrix *= effectFacingMatrix();
 	}
 
 	if (TEST_SCALED(psEffect))
@@ -0,0 +1,284 @@
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2024  Warzone 2100 Project
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/**
+ * @file
+ * Fork server: initialise once, then fork() a headless autohost per request (Linux only).
+ *
+ * The server runs after all startup data loading and before any per-game threads (path finding,
+ * netplay, command interface) are started. The threads that already exist at that point (the URL
+ * request thread and the debug log writer) are stopped while serving and restarted in each child,
+ * so the process is single-threaded when it forks. Children share the already-loaded data with
+ * the server copy-on-write.
+ */
+
+#include "forkserver.h"
+
+#include "lib/framework/frame.h"
+#include "lib/netplay/netplay.h"
+#include "clparse.h"
+#include "main.h"
+#include "stdinreader.h"
+#include "urlrequest.h"
+#include "wrappers.h"
+
+#if defined(WZ_OS_LINUX)
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <ctime>
+#include <poll.h>
+#include <sstream>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static std::string forkServerSocketPath;
+
+void forkServerSetSocketPath(const std::string &path)
+{
+	forkServerSocketPath = path;
+}
+
+bool forkServerEnabled()
+{
+	return !forkServerSocketPath.empty();
+}
+
+#if defined(WZ_OS_LINUX)
+
+static const size_t MAX_REQUEST_LENGTH = 1024;
+static const int REQUEST_TIMEOUT_MS = 5000;
+
+/// Requests are served one at a time, so a client that does not send its request line in time is dropped
+static bool readRequestLine(int fd, std::string &line)
+{
+	line.clear();
+	char c = 0;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(REQUEST_TIMEOUT_MS);
+	while (line.size() < MAX_REQUEST_LENGTH)
+	{
+		int remainingMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+		if (remainingMs <= 0)
+		{
+			debug(LOG_INFO, "Fork server: timed out waiting for a request");
+			return false;
+		}
+		pollfd pfd = {fd, POLLIN, 0};
+		int pollResult = poll(&pfd, 1, remainingMs);
+		if (pollResult < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return false;
+		}
+		if (pollResult == 0)
+		{
+			continue; // timed out (reported above)
+		}
+		ssize_t result = read(fd, &c, 1);
+		if (result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (result <= 0)
+		{
+			return !line.empty();
+		}
+		if (c == '\n')
+		{
+			return true;
+		}
+		line.push_back(c);
+	}
+	return false;
+}
+
+static void writeReply(int fd, const std::string &reply)
+{
+	size_t written = 0;
+	while (written < reply.size())
+	{
+		ssize_t result = send(fd, reply.data() + written, reply.size() - written, MSG_NOSIGNAL);
+		if (result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (result <= 0)
+		{
+			return;
+		}
+		written += static_cast<size_t>(result);
+	}
+}
+
+static int createListenSocket(const std::string &path)
+{
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+	if (strlen(addr.sun_path) != path.length())
+	{
+		debug(LOG_ERROR, "Fork server socket path %s is too long", path.c_str());
+		return -1;
+	}
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd == -1)
+	{
+		debug(LOG_ERROR, "Fork server socket() failed: %s", strerror(errno));
+		return -1;
+	}
+	unlink(addr.sun_path);
+	if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 16) != 0)
+	{
+		debug(LOG_ERROR, "Fork server could not listen on %s: %s", path.c_str(), strerror(errno));
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+ForkServerResult forkServerRun()
+{
+	if (!headlessGameMode())
+	{
+		debug(LOG_ERROR, "--fork-server requires --headless");
+		return ForkServerResult::Failed;
+	}
+	if (GetGameMode() != GS_TITLE_SCREEN)
+	{
+		debug(LOG_ERROR, "--fork-server cannot be combined with options that start or load a game");
+		return ForkServerResult::Failed;
+	}
+
+	int listenFd = createListenSocket(forkServerSocketPath);
+	if (listenFd == -1)
+	{
+		return ForkServerResult::Failed;
+	}
+
+	// Children are reaped automatically
+	signal(SIGCHLD, SIG_IGN);
+
+	debug(LOG_INFO, "Fork server listening on %s", forkServerSocketPath.c_str());
+	// Only the calling thread survives fork(), so stop the threads started during initialisation
+	urlRequestShutdown();
+	debugPauseDeferredOutput(true);
+
+	ForkServerResult result = ForkServerResult::Failed;
+	std::string line;
+	while (true)
+	{
+		int connFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (connFd == -1)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+			{
+				continue;
+			}
+			debug(LOG_ERROR, "Fork server accept() failed: %s", strerror(errno));
+			break;
+		}
+
+		if (!readRequestLine(connFd, line))
+		{
+			close(connFd);
+			continue;
+		}
+
+		std::istringstream request(line);
+		std::string command, autohostConfig, cmdInterfaceSocketPath;
+		unsigned port = 0;
+		request >> command;
+		if (command == "shutdown")
+		{
+			writeReply(connFd, "ok\n");
+			close(connFd);
+			result = ForkServerResult::Quit;
+			break;
+		}
+		if (command != "host" || !(request >> autohostConfig >> port) || port == 0 || port > 65535)
+		{
+			writeReply(connFd, "error expected: host <autohost-config> <port> [<cmdinterface-socket-path>]\n");
+			close(connFd);
+			continue;
+		}
+		request >> cmdInterfaceSocketPath;
+
+		fflush(stdout);
+		fflush(stderr);
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			// child: become a normal headless autohost
+			close(connFd);
+			close(listenFd);
+			signal(SIGCHLD, SIG_DFL);
+			// every child would otherwise start with the server's rand() state (and so pick the same game seeds)
+			srand(static_cast<unsigned int>(time(nullptr)) ^ static_cast<unsigned int>(getpid()));
+			const std::string logSuffix = "-" + std::to_string(getpid());
+			debugReopenLogFiles(logSuffix.c_str());
+			debugPauseDeferredOutput(false);
+			urlRequestInit();
+
+			setHostLaunch(HostLaunch::Autohost);
+			setSkirmishTest(autohostConfig);
+			NETsetGameserverPort(port);
+			netGameserverPortOverride = true; // don't save the per-game port to the config file
+			if (!cmdInterfaceSocketPath.empty())
+			{
+				configSetCmdInterface(WZ_Command_Interface::Unix_Socket, cmdInterfaceSocketPath);
+			}
+			debug(LOG_INFO, "Forked autohost %s on port %u", autohostConfig.c_str(), port);
+			return ForkServerResult::Child;
+		}
+		if (pid < 0)
+		{
+			debug(LOG_ERROR, "Fork server fork() failed: %s", strerror(errno));
+			writeReply(connFd, std::string("error fork failed: ") + strerror(errno) + "\n");
+		}
+		else
+		{
+			writeReply(connFd, "forked " + std::to_string(pid) + "\n");
+		}
+		close(connFd);
+	}
+
+	close(listenFd);
+	unlink(forkServerSocketPath.c_str());
+	debugPauseDeferredOutput(false);
+	urlRequestInit(); // so the caller's shutdown is the same as usual
+	return result;
+}
+
+#else // !defined(WZ_OS_LINUX)
+
+ForkServerResult forkServerRun()
+{
+	debug(LOG_ERROR, "--fork-server is only supported on Linux");
+	return ForkServerResult::Failed;
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2024  Warzone 2100 Project
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/**
+ * @file
+ * Fork server: initialise once, then fork() a headless autohost per request (Linux only).
+ *
+ * Requests are single lines sent over a unix socket, one request per connection:
+ *   host <autohost-config> <port> [<cmdinterface-socket-path>]  ->  "forked <pid>" or "error <message>"
+ *   shutdown                                                     ->  "ok"
+ */
+
+#pragma once
+
+#include <string>
+
+enum class ForkServerResult
+{
+	Child,	///< Running in a forked child, which has been configured to autohost
+	Quit,	///< The server received a shutdown request
+	Failed,	///< The server could not be started (or stopped unexpectedly)
+};
+
+// used from clparse:
+void forkServerSetSocketPath(const std::string &path);
+
+bool forkServerEnabled();
+
+/// Serves requests until shut down. Returns in the parent on shutdown / failure, and in each forked child
+ForkServerResult forkServerRun();
@@ -40,6 +40,7 @@
 
 #include "fpath.h"
 #include "profiling.h"
+#include "perfmetrics.h"
 
 // If the path finding system is shutdown or not
 static volatile bool fpathQuit = false;
@@ -390,8 +391,14 @@ queuePathfinding:
 	// job or result for each droid in the system at any time.
 	fpathRemoveDroidData(id);
 
-	packagedPathJob task([job]() { return fpathExecute(job); });
+	auto queuedTime = std::chrono::steady_clock::now();
+	packagedPathJob task([job, queuedTime]() {
+		PATHRESULT result = fpathExecute(job);
+		perfmetrics::recordPathJobCompleted(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queuedTime).count()));
+		return result;
+	});
 	pathResults[id] = task.get_future();
+	perfmetrics::recordPathJobQueued();
 
 	// Add to end of list
 	wzMutexLock(fpathMutex);
@@ -503,12 +510,16 @@ PATHRESULT fpathExecute(PATHJOB job)
 }
 
 /** Find the length of the job queue. Function is thread-safe. */
-static size_t fpathJobQueueLength()
+size_t fpathJobQueueLength()
 {
 	size_t count = 0;
 
+	if (!fpathMutex)
+	{
+		return 0;  // path system not running
+	}
 	wzMutexLock(fpathMutex);
-	count = pathJobs.size();  // O(N) function call for std::list. .empty() is faster, but this function isn't used except in tests.
+	count = pathJobs.size();  // O(1) since C++11
 	wzMutexUnlock(fpathMutex);
 	return count;
 }
@@ -538,9 +549,6 @@ void fpathTest(int x, int y, int x2, int y2)
 	FPATH_RETVAL r;
 	int i;
 
-	// On non-debug builds prevent warnings about defining but not using fpathJobQueueLength
-	(void)fpathJobQueueLength();
-
 	/* Check initial state */
 	assert(fpathThread != nullptr);
 	assert(fpathMutex != nullptr);
@@ -117,6 +117,9 @@ void fpathSetDirectRoute(DROID *psDroid, SDWORD targetX, SDWORD targetY);
 /** Clean up path jobs and results for a droid. Function is thread-safe. */
 void fpathRemoveDroidData(int id);
 
+/** Number of path jobs waiting for the path-finding thread. Function is thread-safe. */
+size_t fpathJobQueueLength();
+
 /** Quick O(1) test of whether it is theoretically possible to go from origin to destination
  *  using the given propulsion type. orig and dest are in world coordinates. */
 bool fpathCheck(Position orig, Position dest, PROPULSION_TYPE propulsion);
@@ -2654,7 +2654,12 @@ public:
 	bool selectAt(size_t index) const
 	{
 		ASSERT_OR_RETURN(false, index < locales.size(), "Invalid index: %zu", index);
-		return setLanguage(locales[index].code);
+		if (!setLanguage(locales[index].code))
+		{
+			return false;
+		}
+		iV_TextLanguageChanged();
+		return true;
 	}
 
 	size_t getSelectedIndex() const
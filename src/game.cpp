@@ -2568,6 +2568,7 @@ bool loadGame(const char *pGameToLoad, bool keepObjects, bool freeMem, bool User
 			apsExtractorLists[player].clear();
 		}
 		apsOilList[0].clear();
+		objmemInvalidateIdIndex();
 		initFactoryNumFlag();
 	}
 
@@ -2585,6 +2586,7 @@ bool loadGame(const char *pGameToLoad, bool keepObjects, bool freeMem, bool User
 		}
 		mission.apsOilList[0].clear();
 		mission.apsSensorList[0].clear();
+		objmemInvalidateIdIndex();
 
 		// Stuff added after level load to avoid being reset or initialised during load
 		// always !keepObjects
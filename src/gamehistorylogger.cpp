@@ -276,6 +276,134 @@ static nlohmann::json convertToOutputJSON(const GameStoryLogger::GameFrame& fram
 	return result;
 }
 
+/**
+ * Writes lines to a log file on a background thread, so that the game thread never waits on PhysFS.
+ *
+ * Lines queued while the thread is busy are written as one batch, followed by a single flush.
+ */
+class GameStoryLogFileWriter
+{
+public:
+	explicit GameStoryLogFileWriter(PHYSFS_file *handle);
+	~GameStoryLogFileWriter();
+
+	void writeLine(std::string &&line);
+	// Writes any remaining lines and closes the file
+	void close();
+
+private:
+	static int writerThreadFunc(void *data);
+	void stopThread();
+
+private:
+	PHYSFS_file *fileHandle = nullptr; // guarded by writerMutex while the thread runs
+	WZ_THREAD *writerThread = nullptr;
+	WZ_MUTEX *writerMutex = nullptr;
+	WZ_SEMAPHORE *writerSemaphore = nullptr;
+	std::vector<std::string> pendingLines; // guarded by writerMutex
+	bool quit = false; // guarded by writerMutex
+};
+
+GameStoryLogFileWriter::GameStoryLogFileWriter(PHYSFS_file *handle)
+: fileHandle(handle)
+{
+	writerMutex = wzMutexCreate();
+	writerSemaphore = wzSemaphoreCreate(0);
+	writerThread = wzThreadCreate(writerThreadFunc, this, "wzGameStoryLogWriter");
+	wzThreadStart(writerThread);
+}
+
+GameStoryLogFileWriter::~GameStoryLogFileWriter()
+{
+	// If close() was never called, this is shutdown and PhysFS may already be gone - so leave the file handle alone,
+	// and have the thread discard whatever is still queued instead of writing it
+	wzMutexLock(writerMutex);
+	fileHandle = nullptr;
+	wzMutexUnlock(writerMutex);
+	stopThread();
+	wzSemaphoreDestroy(writerSemaphore);
+	wzMutexDestroy(writerMutex);
+}
+
+void GameStoryLogFileWriter::writeLine(std::string &&line)
+{
+	wzMutexLock(writerMutex);
+	pendingLines.push_back(std::move(line));
+	wzMutexUnlock(writerMutex);
+	wzSemaphorePost(writerSemaphore);
+}
+
+void GameStoryLogFileWriter::close()
+{
+	stopThread(); // the thread writes out everything still queued before exiting
+	if (fileHandle)
+	{
+		PHYSFS_close(fileHandle);
+		fileHandle = nullptr;
+	}
+}
+
+void GameStoryLogFileWriter::stopThread()
+{
+	if (!writerThread)
+	{
+		return;
+	}
+	wzMutexLock(writerMutex);
+	quit = true;
+	wzMutexUnlock(writerMutex);
+	wzSemaphorePost(writerSemaphore);
+	wzThreadJoin(writerThread);
+	writerThread = nullptr;
+}
+
+int GameStoryLogFileWriter::writerThreadFunc(void *data)
+{
+	GameStoryLogFileWriter *writer = static_cast<GameStoryLogFileWriter *>(data);
+	std::vector<std::string> lines;
+	bool quitting = false;
+	while (!quitting)
+	{
+		wzSemaphoreWait(writer->writerSemaphore);
+
+		wzMutexLock(writer->writerMutex);
+		lines.swap(writer->pendingLines);
+		quitting = writer->quit;
+		PHYSFS_file *fileHandle = writer->fileHandle;
+		wzMutexUnlock(writer->writerMutex);
+
+		if (lines.empty() || !fileHandle)
+		{
+			lines.clear();
+			continue;
+		}
+		bool failed = false;
+		for (const auto& line : lines)
+		{
+			if (WZ_PHYSFS_writeBytes(fileHandle, line.c_str(), line.size()) != line.size())
+			{
+				// Failed to write line to file
+				debug(LOG_ERROR, "Could not write to output file; PHYSFS error: %s", WZ_PHYSFS_getLastError());
+				failed = true;
+				break;
+			}
+		}
+		if (failed)
+		{
+			PHYSFS_close(fileHandle);
+			wzMutexLock(writer->writerMutex);
+			writer->fileHandle = nullptr;
+			wzMutexUnlock(writer->writerMutex);
+		}
+		else
+		{
+			PHYSFS_flush(fileHandle);
+		}
+		lines.clear();
+	}
+	return 0;
+}
+
 GameStoryLogger& GameStoryLogger::instance()
 {
 	static GameStoryLogger _instance;
@@ -287,6 +415,9 @@ GameStoryLogger::GameStoryLogger()
 	frameLoggingInterval = 15 * GAME_TICKS_PER_SEC;
 }
 
+GameStoryLogger::~GameStoryLogger()
+{ }
+
 void GameStoryLogger::reset()
 {
 	lastRecordedGameFrameTime = 0;
@@ -297,10 +428,10 @@ void GameStoryLogger::reset()
 	gameStartRealTime = std::chrono::system_clock::time_point();
 	gameEndRealTime = std::chrono::system_clock::time_point();
 	cachedGameDetailsOutputJSON = nlohmann::json();
-	if (fileHandle)
+	if (fileWriter)
 	{
-		PHYSFS_close(fileHandle);
-		fileHandle = nullptr;
+		fileWriter->close();
+		fileWriter.reset();
 	}
 }
 
@@ -319,10 +450,11 @@ void GameStoryLogger::logStartGame()
 	if (outputModes.logFile)
 	{
 		WzString outputPath = WzString("logs/") + WzString::fromUtf8(getLogOutputFilename());
-		fileHandle = PHYSFS_openWrite(outputPath.toUtf8().c_str());
+		PHYSFS_file *fileHandle = PHYSFS_openWrite(outputPath.toUtf8().c_str());
 		if (fileHandle)
 		{
 			WZ_PHYSFS_SETBUFFER(fileHandle, 4096)//;
+			fileWriter = std::make_unique<GameStoryLogFileWriter>(fileHandle);
 		}
 		else
 		{
@@ -430,10 +562,10 @@ void GameStoryLogger::logGameOver()
 		outputLine(std::move(reportJSONStr));
 	}
 
-	if (fileHandle)
+	if (fileWriter)
 	{
-		PHYSFS_close(fileHandle);
-		fileHandle = nullptr;
+		fileWriter->close();
+		fileWriter.reset();
 	}
 }
 
@@ -449,10 +581,10 @@ void GameStoryLogger::setOutputNaming(OutputNaming naming)
 
 void GameStoryLogger::setOutputModes(OutputModes enabled)
 {
-	if (outputModes.logFile && !enabled.logFile && fileHandle != nullptr)
+	if (outputModes.logFile && !enabled.logFile && fileWriter)
 	{
-		PHYSFS_close(fileHandle);
-		fileHandle = nullptr;
+		fileWriter->close();
+		fileWriter.reset();
 	}
 	outputModes = enabled;
 }
@@ -661,16 +793,9 @@ void GameStoryLogger::outputLine(std::string &&line)
 	}
 	if (outputModes.logFile)
 	{
-		if (fileHandle)
+		if (fileWriter)
 		{
-			if (WZ_PHYSFS_writeBytes(fileHandle, line.c_str(), line.size()) != line.size())
-			{
-				// Failed to write line to file
-				debug(LOG_ERROR, "Could not write to output file; PHYSFS error: %s", WZ_PHYSFS_getLastError());
-				PHYSFS_close(fileHandle);
-				fileHandle = nullptr;
-			}
-			PHYSFS_flush(fileHandle);
+			fileWriter->writeLine(std::move(line));
 		}
 	}
 }
@@ -22,6 +22,7 @@
 #include <string>
 #include <chrono>
 #include <vector>
+#include <memory>
 #include <physfs.h>
 #include "factionid.h"
 #include "lib/framework/wzstring.h"
@@ -33,6 +34,7 @@ using nonstd::nullopt;
 
 struct RESEARCH;
 struct STRUCTURE;
+class GameStoryLogFileWriter;
 
 class GameStoryLogger
 {
@@ -115,6 +117,7 @@ protected:
 	GameStoryLogger();
 
 public:
+	~GameStoryLogger();
 	static GameStoryLogger& instance();
 
 public:
@@ -155,7 +158,7 @@ private:
 
 private:
 	OutputModes outputModes;
-	PHYSFS_file *fileHandle = nullptr;
+	std::unique_ptr<GameStoryLogFileWriter> fileWriter; // writes log file lines on a background thread
 	OutputKey outputKey = OutputKey::PlayerPosition;
 	OutputNaming outputNaming = OutputNaming::Default;
 	uint32_t frameLoggingInterval = 0;
@@ -40,6 +40,7 @@
 #include "lighting.h"
 #include "display3d.h"
 #include "terrain.h"
+#include "radar.h"
 #include "warzoneconfig.h"
 
 // These magic values determine the fog
@@ -115,6 +116,7 @@ void initLighting(UDWORD x1, UDWORD y1, UDWORD x2, UDWORD y2)
 			}
 		}
 	}
+	radarMarkAllTilesDirty();
 }
 
 // For display purposes only (*NOT* for use in game state calculations)
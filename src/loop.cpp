@@ -87,6 +87,7 @@
 #include "clparse.h"
 #include "gamehistorylogger.h"
 #include "profiling.h"
+#include "perfmetrics.h"
 #include "wzapi.h"
 
 #include "warzoneconfig.h"
@@ -497,6 +498,7 @@ void countUpdate(bool synch)
 static void gameStateUpdate()
 {
 	WZ_PROFILE_SCOPE(gameStateUpdate);
+	perfmetrics::ScopedTickPhase totalPhase(perfmetrics::TickPhase::Total);
 	syncDebug("map = \"%s\", pseudorandom 32-bit integer = 0x%08X, allocated = %d %d %d %d %d %d %d %d %d %d, position = %d %d %d %d %d %d %d %d %d %d", game.map, gameRandU32(),
 	          NetPlay.players[0].allocated, NetPlay.players[1].allocated, NetPlay.players[2].allocated, NetPlay.players[3].allocated, NetPlay.players[4].allocated, NetPlay.players[5].allocated, NetPlay.players[6].allocated, NetPlay.players[7].allocated, NetPlay.players[8].allocated, NetPlay.players[9].allocated,
 	          NetPlay.players[0].position, NetPlay.players[1].position, NetPlay.players[2].position, NetPlay.players[3].position, NetPlay.players[4].position, NetPlay.players[5].position, NetPlay.players[6].position, NetPlay.players[7].position, NetPlay.players[8].position, NetPlay.players[9].position
@@ -520,6 +522,7 @@ static void gameStateUpdate()
 
 	if (!paused && !scriptPaused())
 	{
+		perfmetrics::ScopedTickPhase scriptsPhase(perfmetrics::TickPhase::Scripts);
 		executeFnAndProcessScriptQueuedRemovals([]() { updateScripts(); });
 	}
 
@@ -527,6 +530,7 @@ static void gameStateUpdate()
 	handleAbandonedStructures();
 
 	// Update the visibility change stuff
+	perfmetrics::ScopedTickPhase visibilityPhase(perfmetrics::TickPhase::Visibility);
 	visUpdateLevel();
 
 	// Put all droids/structures/features into the grid.
@@ -534,16 +538,22 @@ static void gameStateUpdate()
 
 	// Check which objects are visible.
 	processVisibility();
+	visibilityPhase.stop();
 
 	// Update the map.
+	perfmetrics::ScopedTickPhase mapPhase(perfmetrics::TickPhase::Map);
 	mapUpdate();
+	mapPhase.stop();
 
 	//update the findpath system
+	perfmetrics::ScopedTickPhase pathsPhase(perfmetrics::TickPhase::Paths);
 	fpathUpdate();
+	pathsPhase.stop();
 
 	// update the command droids
 	cmdDroidUpdate();
 
+	perfmetrics::ScopedTickPhase objectsPhase(perfmetrics::TickPhase::Objects);
 	for (unsigned i = 0; i < MAX_PLAYERS; i++)
 	{
 		//update the current power available for a player
@@ -579,18 +589,25 @@ static void gameStateUpdate()
 			});
 		});
 	}
+	objectsPhase.stop();
 
 	missionTimerUpdate();
 
+	perfmetrics::ScopedTickPhase projectilesPhase(perfmetrics::TickPhase::Projectiles);
 	executeFnAndProcessScriptQueuedRemovals([]() { proj_UpdateAll(); });
+	projectilesPhase.stop();
 
+	perfmetrics::ScopedTickPhase featuresPhase(perfmetrics::TickPhase::Features);
 	for (FEATURE *psCFeat : apsFeatureLists[0])
 	{
 		featureUpdate(psCFeat);
 	}
+	featuresPhase.stop();
 
 	// Free dead droid memory.
+	perfmetrics::ScopedTickPhase objmemPhase(perfmetrics::TickPhase::ObjMem);
 	objmemUpdate();
+	objmemPhase.stop();
 
 	// accumulate occasional stats / snapshots
 	if (!paused && !scriptPaused())
@@ -109,6 +109,8 @@
 #include "activity.h"
 #include "stdinreader.h"
 #include "gamehistorylogger.h"
+#include "perfmetrics.h"
+#include "forkserver.h"
 #include "campaigninfo.h"
 #if defined(ENABLE_DISCORD)
 #include "integrations/wzdiscordrpc.h"
@@ -1368,6 +1370,7 @@ void mainLoop()
 	wzApplyCursor();
 	runNotifications();
 	wz_command_interface_process_queued_status_output();
+	perfmetrics::processPeriodicOutput();
 #if defined(ENABLE_DISCORD)
 	discordRPCPerFrame();
 #endif
@@ -1912,7 +1915,7 @@ int realmain(int argc, char *argv[])
 #if defined(__EMSCRIPTEN__)
 	debug_register_callback(debug_callback_emscripten_log, nullptr, nullptr, nullptr);
 #else
-	debug_register_callback(debug_callback_stderr, nullptr, nullptr, nullptr);
+	debug_register_callback(debug_callback_stderr, nullptr, nullptr, nullptr, true);
 #endif
 #if defined(_WIN32) && defined(DEBUG_INSANE)
 	debug_register_callback(debug_callback_win32debug, NULL, NULL, NULL);
@@ -2027,7 +2030,7 @@ int realmain(int argc, char *argv[])
 		// so we use our write directory to store our logs.
 		WzString debug_filename = PHYSFS_getWriteDir();
 		debug_filename.append(WzString::fromUtf8(getDefaultLogFilePath(PHYSFS_getDirSeparator())));
-		debug_register_callback(debug_callback_file, debug_callback_file_init, debug_callback_file_exit, &debug_filename); // note: by the time this function returns, all use of debug_filename has completed
+		debug_register_callback(debug_callback_file, debug_callback_file_init, debug_callback_file_exit, &debug_filename, true); // note: by the time this function returns, all use of debug_filename has completed
 
 		debug(LOG_WZ, "Using %s debug file", debug_filename.toUtf8().c_str());
 	}
@@ -2179,7 +2182,10 @@ int realmain(int argc, char *argv[])
 
 	initializeCrashHandlingContext(gfxbackend);
 
-	wzCmdInterfaceInit();
+	if (!forkServerEnabled())
+	{
+		wzCmdInterfaceInit();
+	}
 
 	debug(LOG_WZ, "Warzone 2100 - %s", version_getFormattedVersionString(false));
 	debug(LOG_WZ, "Using language: %s", getLanguage());
@@ -2244,6 +2250,21 @@ int realmain(int argc, char *argv[])
 	ssprintf(buf, "Using language: %s", getLanguageName());
 	addDumpInfo(buf);
 
+	if (forkServerEnabled())
+	{
+		// Everything above is shared with the forked autohosts; only the children continue past this point
+		ForkServerResult forkResult = forkServerRun();
+		if (forkResult != ForkServerResult::Child)
+		{
+			// the title loop was never started, so only undo what was set up above
+			urlRequestShutdown();
+			systemShutdown();
+			wzShutdown();
+			return (forkResult == ForkServerResult::Quit) ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+		wzCmdInterfaceInit();
+	}
+
 	// Do the game mode specific initialisation.
 	switch (GetGameMode())
 	{
@@ -278,6 +278,7 @@ void initMission()
 	}
 	mission.apsSensorList[0].clear();
 	mission.apsOilList[0].clear();
+	objmemInvalidateIdIndex();
 	offWorldKeepLists = false;
 	mission.time = -1;
 	setMissionCountDown();
@@ -349,6 +350,7 @@ bool missionShutDown()
 		apsOilList[0] = std::move(mission.apsOilList[0]);
 		mission.apsSensorList[0].clear();
 		mission.apsOilList[0].clear();
+		objmemInvalidateIdIndex();
 
 		psMapTiles = std::move(mission.psMapTiles);
 		mapWidth = mission.mapWidth;
@@ -798,6 +800,7 @@ static void saveMissionData()
 	}
 	mission.apsSensorList[0] = apsSensorList[0];
 	mission.apsOilList[0] = apsOilList[0];
+	objmemInvalidateIdIndex();
 
 	mission.playerX = playerPos.p.x;
 	mission.playerY = playerPos.p.z;
@@ -868,6 +871,7 @@ void restoreMissionData()
 	apsOilList[0] = std::move(mission.apsOilList[0]);
 	mission.apsSensorList[0].clear();
 	apsOilList[0].clear();
+	objmemInvalidateIdIndex();
 	//swap mission data over
 
 	psMapTiles = std::move(mission.psMapTiles);
@@ -932,6 +936,7 @@ void saveMissionLimboData()
 		return IterationResult::CONTINUE_ITERATION;
 	});
 	apsDroidLists[selectedPlayer].clear();
+	objmemInvalidateIdIndex();
 
 	// any selectedPlayer's factories/research need to be put on holdProduction/holdresearch
 	for (STRUCTURE* psStruct : apsStructLists[selectedPlayer])
@@ -1084,6 +1089,7 @@ void saveCampaignData()
 		// Reserve the droids for selected player for start of next campaign
 		mission.apsDroidLists[selectedPlayer] = std::move(apsDroidLists[selectedPlayer]);
 		apsDroidLists[selectedPlayer].clear();
+		objmemInvalidateIdIndex();
 		for (DROID* psDroid : mission.apsDroidLists[selectedPlayer])
 		{
 			//cam change add droid
@@ -1408,6 +1414,7 @@ void swapMissionPointers()
 	}
 	std::swap(apsSensorList[0], mission.apsSensorList[0]);
 	std::swap(apsOilList[0],    mission.apsOilList[0]);
+	objmemInvalidateIdIndex();
 }
 
 void endMission()
@@ -2982,6 +2989,7 @@ void missionDestroyObjects()
 				return IterationResult::CONTINUE_ITERATION;
 			});
 			mission.apsDroidLists[Player].clear();
+			objmemInvalidateIdIndex();
 
 			mutating_list_iterate(apsStructLists[Player], [](STRUCTURE* s)
 			{
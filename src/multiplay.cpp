@@ -545,87 +545,38 @@ bool multiPlayerLoop()
 // to get droids ...
 DROID *IdToDroid(UDWORD id, UDWORD player)
 {
-	if (player == ANYPLAYER)
+	if (player != ANYPLAYER && player >= MAX_PLAYERS)
 	{
-		for (int i = 0; i < MAX_PLAYERS; i++)
-		{
-			DROID* d = (DROID*)getBaseObjFromId(apsDroidLists[i], id);
-			if (d)
-			{
-				return d;
-			}
-		}
-	}
-	else if (player < MAX_PLAYERS)
-	{
-		DROID* d = (DROID*)getBaseObjFromId(apsDroidLists[player], id);
-		if (d)
-		{
-			return d;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return objmemFindIdInLists(apsDroidLists, id, (player == ANYPLAYER) ? MAX_PLAYERS : player);
 }
 
 // find off-world droids
 DROID *IdToMissionDroid(UDWORD id, UDWORD player)
 {
-	if (player == ANYPLAYER)
-	{
-		for (int i = 0; i < MAX_PLAYERS; i++)
-		{
-			DROID* d = (DROID*)getBaseObjFromId(mission.apsDroidLists[i], id);
-			if (d)
-			{
-				return d;
-			}
-		}
-	}
-	else if (player < MAX_PLAYERS)
+	if (player != ANYPLAYER && player >= MAX_PLAYERS)
 	{
-		DROID* d = (DROID*)getBaseObjFromId(mission.apsDroidLists[player], id);
-		if (d)
-		{
-			return d;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return objmemFindIdInLists(mission.apsDroidLists, id, (player == ANYPLAYER) ? MAX_PLAYERS : player);
 }
 
-static STRUCTURE* _IdToStruct(UDWORD id, UDWORD beginPlayer, UDWORD endPlayer)
-{
-	for (int i = beginPlayer; i < endPlayer; ++i)
-	{
-		STRUCTURE* s = (STRUCTURE*)getBaseObjFromId(apsStructLists[i], id);
-		if (s)
-		{
-			return s;
-		}
-		s = (STRUCTURE*)getBaseObjFromId(mission.apsStructLists[i], id);
-		if (s)
-		{
-			return s;
-		}
-	}
-	return nullptr;
-}
 // ////////////////////////////////////////////////////////////////////////////
 // find a structure
 STRUCTURE *IdToStruct(UDWORD id, UDWORD player)
 {
-	int beginPlayer = 0, endPlayer = MAX_PLAYERS;
-	if (player != ANYPLAYER)
+	if (player != ANYPLAYER && player >= MAX_PLAYERS)
 	{
-		beginPlayer = player;
-		endPlayer = std::min<int>(player + 1, MAX_PLAYERS);
+		return nullptr;
 	}
-	STRUCTURE *out = nullptr;
-	out = _IdToStruct(id, beginPlayer, endPlayer);
-	if (out)
+	unsigned searchPlayer = (player == ANYPLAYER) ? MAX_PLAYERS : player;
+	STRUCTURE *psStruct = objmemFindIdInLists(apsStructLists, id, searchPlayer);
+	if (psStruct == nullptr)
 	{
-		return out;
+		psStruct = objmemFindIdInLists(mission.apsStructLists, id, searchPlayer);
 	}
-	return nullptr;
+	return psStruct;
 }
 
 // ////////////////////////////////////////////////////////////////////////////
@@ -633,7 +584,7 @@ STRUCTURE *IdToStruct(UDWORD id, UDWORD player)
 FEATURE *IdToFeature(UDWORD id, UDWORD player)
 {
 	(void)player;	// unused, all features go into player 0
-	return (FEATURE*)getBaseObjFromId(apsFeatureLists[0], id);
+	return objmemFindIdInLists(apsFeatureLists, id, 0);
 }
 
 // ////////////////////////////////////////////////////////////////////////////
@@ -46,6 +46,7 @@
 #include "wzcrashhandlingproviders.h"
 
 #include <algorithm>
+#include <unordered_map>
 
 // the initial value for the object ID
 #define OBJ_ID_INIT 20000
@@ -70,6 +71,18 @@ PerPlayerFlagPositionLists apsFlagPosLists;
 /* The list of destroyed objects */
 DestroyedObjectsList psDestroyedObj;
 
+/* Id lookup tables for the object lists that are searched by id (IdToDroid() and friends).
+ * Kept up to date by the add/remove functions below. Code that moves whole lists around
+ * calls objmemInvalidateIdIndex(), and the tables are then rebuilt on the next lookup. */
+struct ObjectIdIndexEntry
+{
+	BASE_OBJECT *psObj;
+	unsigned player;	///< index of the per-player list the object is in
+};
+typedef std::unordered_map<uint32_t, ObjectIdIndexEntry> ObjectIdIndex;
+static ObjectIdIndex droidIdIndex, missionDroidIdIndex, structIdIndex, missionStructIdIndex, featureIdIndex;
+static bool idIndexValid = false;
+
 /* Forward function declarations */
 #ifdef DEBUG
 static void objListIntegCheck();
@@ -103,6 +116,138 @@ void objmemShutdown()
 	objMemShutdownContainerImpl(GlobalDroidContainer());
 	objMemShutdownContainerImpl(GlobalStructContainer());
 	objMemShutdownContainerImpl(GlobalFeatureContainer());
+	objmemInvalidateIdIndex();
+}
+
+/* Get the id lookup table for a set of object lists, or nullptr if those lists are not indexed */
+static ObjectIdIndex *idIndexForLists(const PerPlayerDroidLists &lists)
+{
+	if (&lists == &apsDroidLists)
+	{
+		return &droidIdIndex;
+	}
+	if (&lists == &mission.apsDroidLists)
+	{
+		return &missionDroidIdIndex;
+	}
+	return nullptr;
+}
+
+static ObjectIdIndex *idIndexForLists(const PerPlayerStructureLists &lists)
+{
+	if (&lists == &apsStructLists)
+	{
+		return &structIdIndex;
+	}
+	if (&lists == &mission.apsStructLists)
+	{
+		return &missionStructIdIndex;
+	}
+	return nullptr;
+}
+
+static ObjectIdIndex *idIndexForLists(const PerPlayerFeatureLists &lists)
+{
+	if (&lists == &apsFeatureLists)
+	{
+		return &featureIdIndex;
+	}
+	return nullptr;
+}
+
+template <typename OBJECT>
+static void rebuildIdIndex(ObjectIdIndex& index, const PerPlayerObjectLists<OBJECT, MAX_PLAYERS>& lists)
+{
+	index.clear();
+	for (unsigned player = 0; player < MAX_PLAYERS; ++player)
+	{
+		for (OBJECT *psObj : lists[player])
+		{
+			// keep the first one, like a search through the lists would
+			index.emplace(psObj->id, ObjectIdIndexEntry{psObj, player});
+		}
+	}
+}
+
+static void rebuildIdIndices()
+{
+	rebuildIdIndex(droidIdIndex, apsDroidLists);
+	rebuildIdIndex(missionDroidIdIndex, mission.apsDroidLists);
+	rebuildIdIndex(structIdIndex, apsStructLists);
+	rebuildIdIndex(missionStructIdIndex, mission.apsStructLists);
+	rebuildIdIndex(featureIdIndex, apsFeatureLists);
+	idIndexValid = true;
+}
+
+template <typename OBJECT>
+static void idIndexAdd(const PerPlayerObjectLists<OBJECT, MAX_PLAYERS> &lists, BASE_OBJECT *psObj, unsigned player)
+{
+	ObjectIdIndex *index = idIndexForLists(lists);
+	if (!idIndexValid || index == nullptr)
+	{
+		return;
+	}
+	auto result = index->emplace(psObj->id, ObjectIdIndexEntry{psObj, player});
+	if (!result.second && result.first->second.psObj != psObj)
+	{
+		idIndexValid = false; // duplicate id, let a rebuild sort out which one a search would find
+	}
+}
+
+template <typename OBJECT>
+static void idIndexRemove(const PerPlayerObjectLists<OBJECT, MAX_PLAYERS> &lists, const BASE_OBJECT *psObj)
+{
+	ObjectIdIndex *index = idIndexForLists(lists);
+	if (!idIndexValid || index == nullptr)
+	{
+		return;
+	}
+	auto it = index->find(psObj->id);
+	if (it != index->end() && it->second.psObj == psObj)
+	{
+		index->erase(it);
+	}
+	else
+	{
+		idIndexValid = false; // removing an object we did not know about
+	}
+}
+
+void objmemInvalidateIdIndex()
+{
+	idIndexValid = false;
+}
+
+template <typename OBJECT>
+static OBJECT *findIdInLists(const PerPlayerObjectLists<OBJECT, MAX_PLAYERS> &lists, uint32_t id, unsigned player)
+{
+	if (!idIndexValid)
+	{
+		rebuildIdIndices();
+	}
+	const ObjectIdIndex *index = idIndexForLists(lists);
+	ASSERT_OR_RETURN(nullptr, index != nullptr, "Object lists are not indexed");
+	auto it = index->find(id);
+	if (it == index->end() || (player < MAX_PLAYERS && it->second.player != player))
+	{
+		return nullptr;
+	}
+	return static_cast<OBJECT *>(it->second.psObj);
+}
+
+DROID *objmemFindIdInLists(const PerPlayerDroidLists &lists, uint32_t id, unsigned player)
+{
+	return findIdInLists(lists, id, player);
+}
+
+STRUCTURE *objmemFindIdInLists(const PerPlayerStructureLists &lists, uint32_t id, unsigned player)
+{
+	return findIdInLists(lists, id, player);
+}
+
+FEATURE *objmemFindIdInLists(const PerPlayerFeatureLists &lists, uint32_t id, unsigned player)
+{
+	return findIdInLists(lists, id, player);
 }
 
 static const char* objTypeToStr(OBJECT_TYPE type)
@@ -370,6 +515,7 @@ static inline void addObjectToList(PerPlayerObjectLists<OBJECT, MAX_PLAYERS>& li
 
 	// Prepend the object to the top of the list
 	list[player].emplace_front(object);
+	idIndexAdd(list, object, player);
 }
 
 /* Add the object to its list
@@ -402,6 +548,7 @@ static inline void destroyObject(PerPlayerObjectLists<OBJECT, MAX_PLAYERS>& list
 	if (it != list[object->player].end())
 	{
 		list[object->player].erase(it);
+		idIndexRemove(list, object);
 
 		// Prepend the object to the destruction list
 		psDestroyedObj.emplace_front((BASE_OBJECT*)object);
@@ -425,6 +572,7 @@ static inline void removeObjectFromList(PerPlayerObjectLists<OBJECT, MAX_PLAYERS
 	auto it = std::find(list[player].begin(), list[player].end(), object);
 	ASSERT_OR_RETURN(, it != list[player].end(), "Object %p not found in list", static_cast<void*>(object));
 	list[player].erase(it);
+	idIndexRemove(list, object);
 }
 
 /* Remove an object from the relevant function list. An object can only be in one function list at a time!
@@ -461,6 +609,7 @@ static inline void releaseAllObjectsInList(PerPlayerObjectLists<OBJECT, MAX_PLAY
 		}
 		list.clear();
 	}
+	objmemInvalidateIdIndex();
 }
 
 /***************************************************************************************
@@ -597,6 +746,7 @@ static void freeAllEntitiesImpl(PerPlayerObjectLists<Entity, PlayerCount>& entit
 		}
 		list.clear();
 	}
+	objmemInvalidateIdIndex();
 }
 
 /* Remove all droids */
@@ -1127,6 +1277,17 @@ static void objListIntegCheck()
 	{
 		ASSERT(obj->died > 0, "objListIntegCheck: Object in destroyed list but not dead!");
 	}
+	for (player = 0; player < MAX_PLAYERS; player += 1)
+	{
+		for (const DROID* psCurr : apsDroidLists[player])
+		{
+			ASSERT(objmemFindIdInLists(apsDroidLists, psCurr->id, player) != nullptr, "objListIntegCheck: droid %u missing from the id index", psCurr->id);
+		}
+		for (const STRUCTURE* psStruct : apsStructLists[player])
+		{
+			ASSERT(objmemFindIdInLists(apsStructLists, psStruct->id, player) != nullptr, "objListIntegCheck: structure %u missing from the id index", psStruct->id);
+		}
+	}
 }
 #endif
 
@@ -25,13 +25,19 @@
 #define __INCLUDED_SRC_OBJMEM_H__
 
 #include "objectdef.h"
+#include "lib/framework/pooled_list_allocator.h"
 
 #include <array>
 #include <list>
 
-/* The lists of objects allocated */
+/* The lists of objects allocated.
+ * The list nodes come from a shared pool, so that the per-tick sweeps over these lists walk
+ * mostly contiguous memory, while keeping the stable iterators and the ordering of std::list. */
+template <typename ObjectType>
+using ObjectList = std::list<ObjectType*, PooledListAllocator<ObjectType*>>;
+
 template <typename ObjectType, unsigned PlayerCount>
-using PerPlayerObjectLists = std::array<std::list<ObjectType*>, PlayerCount>;
+using PerPlayerObjectLists = std::array<ObjectList<ObjectType>, PlayerCount>;
 
 using PerPlayerDroidLists = PerPlayerObjectLists<DROID, MAX_PLAYERS>;
 using DroidList = typename PerPlayerDroidLists::value_type;
@@ -78,6 +84,16 @@ void objmemUpdate();
  * Hopefully by this time, no pointers still refer to it! */
 bool objmemDestroy(BASE_OBJECT* psObj, bool checkRefs);
 
+/* Must be called after objects are moved between, or removed from, the object lists
+ * other than through the functions in this file (e.g. swapping whole lists) */
+void objmemInvalidateIdIndex();
+
+/* Find an object by id in apsDroidLists, apsStructLists, apsFeatureLists, mission.apsDroidLists
+ * or mission.apsStructLists, without walking the lists. Searches all players if player >= MAX_PLAYERS. */
+DROID *objmemFindIdInLists(const PerPlayerDroidLists &lists, uint32_t id, unsigned player);
+STRUCTURE *objmemFindIdInLists(const PerPlayerStructureLists &lists, uint32_t id, unsigned player);
+FEATURE *objmemFindIdInLists(const PerPlayerFeatureLists &lists, uint32_t id, unsigned player);
+
 /// Generates a new, (hopefully) unique object id.
 uint32_t generateNewObjectId();
 /// Generates a new, (hopefully) unique object id, which all clients agree on.
@@ -136,8 +152,8 @@ void freeAllFlagPositions();
 void addFlagPositionToList(FLAG_POSITION* psFlagPosToAdd, PerPlayerFlagPositionLists& list);
 
 // Find a base object from it's id
-template <typename ObjectType>
-BASE_OBJECT* getBaseObjFromId(const std::list<ObjectType*>& list, unsigned id)
+template <typename ObjectType, typename Alloc>
+BASE_OBJECT* getBaseObjFromId(const std::list<ObjectType*, Alloc>& list, unsigned id)
 {
 	auto objIt = std::find_if(list.begin(), list.end(), [id](ObjectType* obj)
 	{
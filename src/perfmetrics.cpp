@@ -0,0 +1,216 @@
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2024  Warzone 2100 Project
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/**
+ * @file
+ * Runtime performance counters, reported through the command interface.
+ */
+
+#include "perfmetrics.h"
+
+#include "lib/framework/wzglobal.h" // required for config.h
+#include "lib/framework/frame.h"
+#include "lib/framework/wzapp.h"
+#include "lib/gamelib/gtime.h"
+#include "lib/netplay/netplay.h"
+#include "objmem.h"
+#include "fpath.h"
+#include "qtscript.h"
+#include "stdinreader.h"
+
+#include <array>
+#include <atomic>
+#include <nlohmann/json.hpp>
+
+namespace perfmetrics
+{
+
+/// Bucket i counts samples below (16 << i) usec; the last bucket counts everything above
+static constexpr size_t NUM_HISTOGRAM_BUCKETS = 16;
+static constexpr uint64_t FIRST_BUCKET_LIMIT_US = 16;
+
+struct Histogram
+{
+	std::atomic<uint64_t> count{0};
+	std::atomic<uint64_t> totalUs{0};
+	std::atomic<uint64_t> maxUs{0};
+	std::array<std::atomic<uint64_t>, NUM_HISTOGRAM_BUCKETS> buckets;
+
+	Histogram()
+	{
+		for (auto& bucket : buckets)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void record(uint64_t us)
+	{
+		size_t bucket = 0;
+		for (uint64_t limit = FIRST_BUCKET_LIMIT_US; us >= limit && bucket < NUM_HISTOGRAM_BUCKETS - 1; limit <<= 1)
+		{
+			++bucket;
+		}
+		buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		count.fetch_add(1, std::memory_order_relaxed);
+		totalUs.fetch_add(us, std::memory_order_relaxed);
+		uint64_t prevMax = maxUs.load(std::memory_order_relaxed);
+		while (us > prevMax && !maxUs.compare_exchange_weak(prevMax, us, std::memory_order_relaxed))
+		{ }
+	}
+
+	nlohmann::ordered_json toJSON() const
+	{
+		auto j = nlohmann::ordered_json::object();
+		j["n"] = count.load(std::memory_order_relaxed);
+		j["total_us"] = totalUs.load(std::memory_order_relaxed);
+		j["max_us"] = maxUs.load(std::memory_order_relaxed);
+		auto jsonBuckets = nlohmann::ordered_json::array();
+		for (const auto& bucket : buckets)
+		{
+			jsonBuckets.push_back(bucket.load(std::memory_order_relaxed));
+		}
+		j["buckets"] = std::move(jsonBuckets);
+		return j;
+	}
+};
+
+static const char *tickPhaseNames[] = {"scripts", "visibility", "map", "paths", "objects", "projectiles", "features", "objmem", "total"};
+static_assert(sizeof(tickPhaseNames) / sizeof(tickPhaseNames[0]) == static_cast<size_t>(TickPhase::Count), "tickPhaseNames must match TickPhase");
+
+static std::array<Histogram, static_cast<size_t>(TickPhase::Count)> tickPhases;
+static std::atomic<uint64_t> pathJobsQueued{0};
+static std::atomic<uint64_t> pathJobsCompleted{0};
+static Histogram pathJobLatency;
+
+static uint32_t periodicOutputInterval = 0; // ms
+static uint32_t lastPeriodicOutput = 0;
+
+void recordTickPhase(TickPhase phase, uint64_t microseconds)
+{
+	tickPhases[static_cast<size_t>(phase)].record(microseconds);
+}
+
+void recordPathJobQueued()
+{
+	pathJobsQueued.fetch_add(1, std::memory_order_relaxed);
+}
+
+void recordPathJobCompleted(uint64_t latencyMicroseconds)
+{
+	pathJobLatency.record(latencyMicroseconds);
+	pathJobsCompleted.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string snapshotJSON()
+{
+	auto root = nlohmann::ordered_json::object();
+	root["ver"] = 1;
+	root["realTime"] = wzGetTicks();
+	root["gameTime"] = gameTime;
+
+	auto bucketLimits = nlohmann::ordered_json::array();
+	for (size_t i = 0; i < NUM_HISTOGRAM_BUCKETS - 1; ++i)
+	{
+		bucketLimits.push_back(FIRST_BUCKET_LIMIT_US << i);
+	}
+	root["bucketLimitsUs"] = std::move(bucketLimits);
+
+	auto tick = nlohmann::ordered_json::object();
+	for (size_t i = 0; i < tickPhases.size(); ++i)
+	{
+		tick[tickPhaseNames[i]] = tickPhases[i].toJSON();
+	}
+	root["tick"] = std::move(tick);
+
+	auto paths = nlohmann::ordered_json::object();
+	paths["queued"] = pathJobsQueued.load(std::memory_order_relaxed);
+	paths["completed"] = pathJobsCompleted.load(std::memory_order_relaxed);
+	paths["queueLength"] = fpathJobQueueLength();
+	paths["latency"] = pathJobLatency.toJSON();
+	root["paths"] = std::move(paths);
+
+	auto scripts = nlohmann::ordered_json::array();
+	for (const auto& load : scriptPerformanceSnapshot())
+	{
+		auto j = nlohmann::ordered_json::object();
+		j["name"] = load.instance->scriptName();
+		j["player"] = load.instance->player();
+		j["calls"] = load.calls;
+		j["time_us"] = load.time;
+		j["worstTick_us"] = load.worstTickTime;
+		j["ticksOverBudget"] = load.ticksOverBudget;
+		scripts.push_back(std::move(j));
+	}
+	root["scripts"] = std::move(scripts);
+
+	auto net = nlohmann::ordered_json::array();
+	for (uint32_t player = 0; player < MAX_CONNECTED_PLAYERS; ++player)
+	{
+		auto pendingBytes = NETgetPendingWriteBytes(player);
+		if (!pendingBytes.has_value())
+		{
+			continue;
+		}
+		auto j = nlohmann::ordered_json::object();
+		j["player"] = player;
+		j["pendingBytes"] = pendingBytes.value();
+		net.push_back(std::move(j));
+	}
+	root["net"] = std::move(net);
+
+	size_t numDroids = 0;
+	size_t numStructures = 0;
+	size_t numFeatures = 0;
+	for (unsigned player = 0; player < MAX_PLAYERS; ++player)
+	{
+		numDroids += apsDroidLists[player].size();
+		numStructures += apsStructLists[player].size();
+		numFeatures += apsFeatureLists[player].size();
+	}
+	auto objects = nlohmann::ordered_json::object();
+	objects["droids"] = numDroids;
+	objects["structures"] = numStructures;
+	objects["features"] = numFeatures;
+	root["objects"] = std::move(objects);
+
+	return std::string("__WZMETRICS__") + root.dump(-1, ' ', false, nlohmann::ordered_json::error_handler_t::replace) + "__ENDWZMETRICS__\n";
+}
+
+void setPeriodicOutputInterval(uint32_t seconds)
+{
+	periodicOutputInterval = seconds * 1000;
+	lastPeriodicOutput = static_cast<uint32_t>(wzGetTicks());
+}
+
+void processPeriodicOutput()
+{
+	if (periodicOutputInterval == 0 || !wz_command_interface_enabled())
+	{
+		return;
+	}
+	uint32_t now = static_cast<uint32_t>(wzGetTicks());
+	if (now - lastPeriodicOutput < periodicOutputInterval)
+	{
+		return;
+	}
+	lastPeriodicOutput = now;
+	wz_command_interface_output_str(snapshotJSON().c_str());
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2024  Warzone 2100 Project
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/**
+ * @file
+ * Runtime performance counters, reported through the command interface.
+ *
+ * Counters are fixed-size relaxed atomics, so recording a sample never locks or allocates.
+ * Tick and path counters only ever increase, so consumers can diff successive snapshots.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace perfmetrics
+{
+
+/// The parts of gameStateUpdate() whose (wall-clock) cost is tracked
+enum class TickPhase
+{
+	Scripts,
+	Visibility,
+	Map,
+	Paths,
+	Objects,
+	Projectiles,
+	Features,
+	ObjMem,
+	Total,
+	Count
+};
+
+/// Adds one sample to the histogram of a tick phase. May be called from any thread
+void recordTickPhase(TickPhase phase, uint64_t microseconds);
+
+/// Path-finding jobs: queued from the game thread, completed on the wzPath thread
+void recordPathJobQueued();
+void recordPathJobCompleted(uint64_t latencyMicroseconds);
+
+/// Records the time spent in the enclosing scope against a tick phase
+class ScopedTickPhase
+{
+public:
+	explicit ScopedTickPhase(TickPhase phase)
+	: phase(phase)
+	, start(std::chrono::steady_clock::now())
+	{ }
+	~ScopedTickPhase()
+	{
+		stop();
+	}
+
+	/// Records the phase now instead of at the end of the scope
+	void stop()
+	{
+		if (stopped)
+		{
+			return;
+		}
+		stopped = true;
+		recordTickPhase(phase, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+	}
+
+	ScopedTickPhase(const ScopedTickPhase&) = delete;
+	ScopedTickPhase& operator=(const ScopedTickPhase&) = delete;
+
+private:
+	TickPhase phase;
+	std::chrono::steady_clock::time_point start;
+	bool stopped = false;
+};
+
+/// Builds the JSON snapshot of all counters (main thread only)
+std::string snapshotJSON();
+
+/// Write a snapshot to the command interface every `seconds` (0 disables)
+void setPeriodicOutputInterval(uint32_t seconds);
+/// Called from the main loop
+void processPeriodicOutput();
+
+}
@@ -39,6 +39,7 @@
 #include "intdisplay.h"
 
 #include <fmt/core.h>
+#include <unordered_map>
 
 #define EXTRACT_POINTS      1
 #define MAX_POWER           1000000
@@ -61,11 +62,135 @@ struct PowerRequest
 	unsigned id;                  ///< Structure which is requesting power.
 };
 
+/// Power requests in the order they were first made, with O(log n) lookup of the power requested up to and including any request.
+/// Deleted requests leave a zero-amount hole, which is compacted away once holes outnumber live requests (this does not change the order).
+class PowerQueue
+{
+public:
+	void clear()
+	{
+		requests.clear();
+		tree.clear();
+		slotOf.clear();
+		total = 0;
+		holes = 0;
+	}
+
+	/// Sets the amount of the request with this id, appending it to the queue if new.
+	/// Returns the power requested by this and all earlier requests.
+	int64_t set(unsigned id, int64_t amount)
+	{
+		auto it = slotOf.find(id);
+		if (it == slotOf.end())
+		{
+			const int64_t before = total;
+			append(id, amount);
+			return before + amount;
+		}
+		const size_t slot = it->second;
+		const int64_t before = prefixSum(slot);
+		add(slot, amount - requests[slot].amount);
+		requests[slot].amount = amount;
+		return before + amount;
+	}
+
+	void remove(unsigned id)
+	{
+		auto it = slotOf.find(id);
+		if (it == slotOf.end())
+		{
+			return;
+		}
+		const size_t slot = it->second;
+		slotOf.erase(it);
+		add(slot, -requests[slot].amount);
+		requests[slot].amount = 0;
+		++holes;
+		if (holes > 32 && holes > slotOf.size())
+		{
+			compact();
+		}
+	}
+
+	/// Power requested by this and all earlier requests, or -1 if there is no request with this id.
+	int64_t requiredUpTo(unsigned id) const
+	{
+		auto it = slotOf.find(id);
+		if (it == slotOf.end())
+		{
+			return -1;
+		}
+		return prefixSum(it->second + 1);
+	}
+
+	int64_t totalRequested() const
+	{
+		return total;
+	}
+
+private:
+	/// Sum of the amounts of the first count slots
+	int64_t prefixSum(size_t count) const
+	{
+		int64_t sum = 0;
+		for (size_t i = count; i > 0; i &= i - 1)
+		{
+			sum += tree[i - 1];
+		}
+		return sum;
+	}
+
+	void add(size_t slot, int64_t delta)
+	{
+		for (size_t i = slot + 1; i <= tree.size(); i += i & (~i + 1))
+		{
+			tree[i - 1] += delta;
+		}
+		total += delta;
+	}
+
+	void append(unsigned id, int64_t amount)
+	{
+		const size_t i = requests.size() + 1;  // 1-based Fenwick index of the new slot
+		const size_t lowBit = i & (~i + 1);
+		// Node i covers slots (i - lowBit, i]
+		tree.push_back(amount + prefixSum(i - 1) - prefixSum(i - lowBit));
+		requests.push_back({amount, id});
+		slotOf[id] = i - 1;
+		total += amount;
+	}
+
+	void compact()
+	{
+		std::vector<PowerRequest> live;
+		live.reserve(slotOf.size());
+		for (size_t slot = 0; slot < requests.size(); ++slot)
+		{
+			auto it = slotOf.find(requests[slot].id);
+			if (it != slotOf.end() && it->second == slot)  // otherwise a hole (possibly of an id that was requested again later)
+			{
+				live.push_back(requests[slot]);
+			}
+		}
+		clear();
+		for (const PowerRequest &request : live)
+		{
+			append(request.id, request.amount);
+		}
+	}
+
+	std::vector<PowerRequest> requests;            ///< In queue order, including holes left by removed requests
+	std::vector<int64_t> tree;                     ///< Fenwick tree over requests[].amount
+	std::unordered_map<unsigned, size_t> slotOf;   ///< Structure id -> index into requests
+	int64_t total = 0;
+	size_t holes = 0;
+};
+
 struct PlayerPower
 {
 	// All fields are 32.32 fixed point.
 	int64_t currentPower;                  ///< The current amount of power available to the player.
-	std::vector<PowerRequest> powerQueue;  ///< Requested power.
+	PowerQueue powerQueue;                 ///< Requested power.
 	int powerModifier;                     ///< Percentage modifier on power from each derrick.
 	int64_t maxStorage;                    ///< Maximum storage of power, in total.
 	int64_t extractedPower;                ///< Total amount of extracted power in this game.
@@ -114,18 +239,7 @@ static bool addPowerRequest(unsigned player, unsigned id, int64_t amount)
 {
 	PlayerPower *p = &asPower[player];
 
-	int64_t requiredPower = amount;
-	size_t n;
-	for (n = 0; n < p->powerQueue.size() && p->powerQueue[n].id != id; ++n)
-	{
-		requiredPower += p->powerQueue[n].amount;
-	}
-	if (n == p->powerQueue.size())
-	{
-		p->powerQueue.resize(n + 1);
-		p->powerQueue[n].id = id;
-	}
-	p->powerQueue[n].amount = amount;
+	int64_t requiredPower = p->powerQueue.set(id, amount);
 	return requiredPower <= p->currentPower;
 }
 
@@ -134,14 +248,7 @@ void delPowerRequest(STRUCTURE *psStruct)
 	ASSERT_NOT_NULLPTR_OR_RETURN(, psStruct);
 	PlayerPower *p = &asPower[psStruct->player];
 
-	for (size_t n = 0; n < p->powerQueue.size(); ++n)
-	{
-		if (p->powerQueue[n].id == psStruct->id)
-		{
-			p->powerQueue.erase(p->powerQueue.begin() + n);
-			return;
-		}
-	}
+	p->powerQueue.remove(psStruct->id);
 }
 
 static int64_t checkPrecisePowerRequest(const STRUCTURE *psStruct)
@@ -149,21 +256,12 @@ static int64_t checkPrecisePowerRequest(const STRUCTURE *psStruct)
 	ASSERT_NOT_NULLPTR_OR_RETURN(-1, psStruct);
 	PlayerPower const *p = &asPower[psStruct->player];
 
-	int64_t requiredPower = 0;
-	for (size_t n = 0; n < p->powerQueue.size(); ++n)
+	int64_t requiredPower = p->powerQueue.requiredUpTo(psStruct->id);
+	if (requiredPower == -1 || requiredPower <= p->currentPower)
 	{
-		requiredPower += p->powerQueue[n].amount;
-		if (p->powerQueue[n].id == psStruct->id)
-		{
-			if (requiredPower <= p->currentPower)
-			{
-				return -1;  // Have enough power.
-			}
-			return requiredPower - p->currentPower;
-		}
+		return -1;  // No request, or have enough power.
 	}
-
-	return -1;
+	return requiredPower - p->currentPower;
 }
 
 int32_t checkPowerRequest(const STRUCTURE *psStruct)
@@ -174,26 +272,12 @@ int32_t checkPowerRequest(const STRUCTURE *psStruct)
 
 static int64_t getPreciseQueuedPower(unsigned player)
 {
-	PlayerPower const *p = &asPower[player];
-
-	int64_t requiredPower = 0;
-	for (size_t n = 0; n < p->powerQueue.size(); ++n)
-	{
-		requiredPower += p->powerQueue[n].amount;
-	}
-	return requiredPower;
+	return asPower[player].powerQueue.totalRequested();
 }
 
 int getQueuedPower(int player)
 {
-	PlayerPower const *p = &asPower[player];
-
-	int64_t requiredPower = 0;
-	for (size_t n = 0; n < p->powerQueue.size(); ++n)
-	{
-		requiredPower += p->powerQueue[n].amount;
-	}
-	return requiredPower / FP_ONE;
+	return asPower[player].powerQueue.totalRequested() / FP_ONE;
 }
 
 static void syncDebugEconomy(unsigned player, char ch)
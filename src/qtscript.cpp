@@ -46,6 +46,7 @@
 #include "qtscript.h"
 
 #include "lib/framework/file.h"
+#include "lib/framework/crc.h"
 #include "lib/gamelib/gtime.h"
 #include "lib/netplay/netplay.h"
 #include "multiplay.h"
@@ -73,6 +74,7 @@
 #include <iomanip>
 #include <queue>
 #include <limits>
+#include <algorithm>
 
 #include "wzscriptdebug.h"
 #include "quickjs_backend.h"
@@ -197,6 +199,7 @@ void scripting_engine::timerNode::swap(timerNode& _rhs)
 	std::swap(player, _rhs.player);
 	std::swap(calls, _rhs.calls);
 	std::swap(type, _rhs.type);
+	std::swap(sequence, _rhs.sequence);
 }
 
 scripting_engine::area_by_values_or_area_label_lookup::area_by_values_or_area_label_lookup() { }
@@ -212,6 +215,30 @@ scripting_engine::area_by_values_or_area_label_lookup::area_by_values_or_area_la
 #define MAX_US 20000
 #define HALF_MAX_US 10000
 
+/// Per-tick time budget for a single scripting instance; exceeding it is counted and logged
+#define TICK_BUDGET_US MAX_US
+
+/// Repeating timers have their first invocation delayed by up to this many game updates, so
+/// that timers set at the same moment (e.g. by every AI in eventStartLevel) do not all fire
+/// on the same tick forever after.
+#define TIMER_MAX_PHASE_UPDATES 10
+
+/// Deterministic phase offset for a repeating timer. This must give the same result on every
+/// peer, so it only depends on data that scripts provide identically everywhere (not on
+/// timerIDs, which also count timers of host-only AI scripts).
+static int timerPhaseOffset(const std::string& timerName, int player, int milliseconds)
+{
+	int updates = std::min<int>(milliseconds / GAME_TICKS_PER_UPDATE, TIMER_MAX_PHASE_UPDATES);
+	if (updates <= 1)
+	{
+		return 0;
+	}
+	uint32_t hash = wz::crc_update(wz::crc_init(), timerName.data(), timerName.size());
+	const uint8_t playerBytes[4] = {static_cast<uint8_t>(player), static_cast<uint8_t>(player >> 8), static_cast<uint8_t>(player >> 16), static_cast<uint8_t>(player >> 24)}; // little-endian on every peer
+	hash = wz::crc_update(hash, playerBytes, sizeof(playerBytes));
+	return static_cast<int>(hash % static_cast<uint32_t>(updates)) * GAME_TICKS_PER_UPDATE;
+}
+
 
 uniqueTimerID scripting_engine::getNextAvailableTimerID()
 {
@@ -232,8 +259,11 @@ uniqueTimerID scripting_engine::setTimer(wzapi::scripting_instance *caller, cons
 	}
 	node->type = type;
 	node->timerID = newTimerID;
-	auto inserted_iter = timers.emplace(timers.end(), std::move(node));
-	timerIDMap[newTimerID] = inserted_iter;
+	if (type == TIMER_REPEAT)
+	{
+		node->frameTime += timerPhaseOffset(node->timerName, player, milliseconds);
+	}
+	addTimerNode(std::move(node));
 	return newTimerID;
 }
 
@@ -241,10 +271,24 @@ uniqueTimerID scripting_engine::setTimer(wzapi::scripting_instance *caller, cons
 void scripting_engine::addTimerNode(std::shared_ptr<scripting_engine::timerNode>&& node)
 {
 	ASSERT(timerIDMap.count(node->timerID) == 0, "Duplicate timerID found: %s", WzString::number(node->timerID).toUtf8().c_str());
+	node->sequence = ++lastTimerSequence;
+	if (node->type == TIMER_ONESHOT_DONE)
+	{
+		finishedTimerIDs.push_back(node->timerID);
+	}
+	else
+	{
+		scheduleTimerNode(node);
+	}
 	auto inserted_iter = timers.emplace(timers.end(), std::move(node));
 	timerIDMap[(*inserted_iter)->timerID] = inserted_iter;
 }
 
+void scripting_engine::scheduleTimerNode(const std::shared_ptr<timerNode>& node)
+{
+	timerQueue.push(timerQueueEntry{node->frameTime, node->sequence, node});
+}
+
 /// Scripting engine (what others call the scripting context, but QtScript's nomenclature is different).
 static std::vector<wzapi::scripting_instance *> scripts;
 
@@ -275,6 +319,9 @@ typedef struct monitor_bin
 } MONITOR_BIN;
 typedef std::unordered_map<std::string, MONITOR_BIN> MONITOR;
 static std::unordered_map<wzapi::scripting_instance *, MONITOR *> monitors;
+/// Per-instance totals over all monitored functions, for finding the script that makes ticks slow
+static std::unordered_map<wzapi::scripting_instance *, scripting_engine::instancePerformanceSnapshot> instanceLoads;
+static std::unordered_map<wzapi::scripting_instance *, uint32_t> instanceTickTime; // usec spent in the current tick
 
 static bool globalDialog = false;
 
@@ -436,6 +483,11 @@ bool scripting_engine::shutdownScripts()
 			info << function << "\n";
 			instance->dumpScriptLog(info.str());
 		}
+		const auto &load = instanceLoads[instance];
+		std::ostringstream total;
+		total << "total: " << load.calls << " calls, " << load.time << " usec, worst tick " << load.worstTickTime << " usec at " << load.worstTickGameTime;
+		total << ", " << load.ticksOverBudget << " ticks over budget of " << TICK_BUDGET_US << " usec\n";
+		instance->dumpScriptLog(total.str());
 		monitor->clear();
 		delete monitor;
 		unregisterFunctions(instance);
@@ -443,7 +495,12 @@ bool scripting_engine::shutdownScripts()
 	timers.clear();
 	lastTimerID = 0;
 	timerIDMap.clear();
+	timerQueue = decltype(timerQueue)();
+	finishedTimerIDs.clear();
+	lastTimerSequence = 0;
 	monitors.clear();
+	instanceLoads.clear();
+	instanceTickTime.clear();
 	for (auto& script : scripts)
 	{
 		delete script;
@@ -469,32 +526,72 @@ bool scripting_engine::updateScripts()
 		selectionChanged = false;
 	}
 
+	// Account the script time spent since the last update to each instance
+	for (auto &it : instanceTickTime)
+	{
+		auto &load = instanceLoads[it.first];
+		load.lastTickTime = it.second;
+		if (it.second > load.worstTickTime)
+		{
+			load.worstTickTime = it.second;
+			load.worstTickGameTime = gameTime;
+		}
+		if (it.second > TICK_BUDGET_US)
+		{
+			load.ticksOverBudget++;
+			debug(LOG_SCRIPT, "%s:%d took %uus in one tick at time %u", it.first->scriptName().c_str(), it.first->player(), it.second, gameTime);
+		}
+		it.second = 0;
+	}
+
 	// Update gameTime
 	for (auto *instance : scripts)
 	{
 		instance->updateGameTime(gameTime);
 	}
 	// Weed out dead timers
-	removeTimersIf([](const timerNode& node)
+	for (uniqueTimerID timerID : finishedTimerIDs)
 	{
-		return (node.type == TIMER_ONESHOT_DONE);
-	});
-	// Check for timers, and run them if applicable.
-	// TODO - load balancing
+		auto it = timerIDMap.find(timerID);
+		if (it != timerIDMap.end() && (*it->second)->type == TIMER_ONESHOT_DONE)
+		{
+			removeTimer(timerID);
+		}
+	}
+	finishedTimerIDs.clear();
+	// Pop the timers that are due. Run them in insertion order, as they are independent of each other
+	// but scripts may still (unwittingly) depend on that order.
 	std::vector<std::shared_ptr<timerNode>> runlist; // make a new list here, since we might trample all over the timer list during execution
-	for (auto &node : timers)
+	while (!timerQueue.empty() && timerQueue.top().frameTime <= static_cast<int>(gameTime))
 	{
-		if (node->frameTime <= gameTime)
+		timerQueueEntry entry = timerQueue.top();
+		timerQueue.pop();
+		std::shared_ptr<timerNode> node = entry.node.lock();
+		if (!node || node->type == TIMER_REMOVED || node->type == TIMER_ONESHOT_DONE || node->frameTime != entry.frameTime)
 		{
-			node->frameTime = node->ms + gameTime;	// update for next invokation
-			if (node->type == TIMER_ONESHOT_READY)
-			{
-				node->type = TIMER_ONESHOT_DONE; // unless there is none
-			}
-			node->calls++;
-			runlist.push_back(node);
+			continue; // stale entry
 		}
+		node->frameTime = node->ms + gameTime;	// update for next invokation
+		if (node->type == TIMER_ONESHOT_READY)
+		{
+			node->type = TIMER_ONESHOT_DONE; // unless there is none
+			finishedTimerIDs.push_back(node->timerID);
+		}
+		node->calls++;
+		runlist.push_back(std::move(node));
 	}
+	// Reschedule repeating timers only now, so that a timer with an interval <= 0 runs once per tick
+	// (instead of being popped again in the loop above forever)
+	for (const auto &node : runlist)
+	{
+		if (node->type != TIMER_ONESHOT_DONE)
+		{
+			scheduleTimerNode(node);
+		}
+	}
+	std::sort(runlist.begin(), runlist.end(), [](const std::shared_ptr<timerNode>& a, const std::shared_ptr<timerNode>& b) {
+		return a->sequence < b->sequence;
+	});
 
 	for (auto &node : runlist)
 	{
@@ -680,6 +777,8 @@ wzapi::scripting_instance* scripting_engine::loadPlayerScript(const WzString& pa
 
 	MONITOR *monitor = new MONITOR;
 	monitors[pNewInstance] = monitor;
+	instanceLoads[pNewInstance].instance = pNewInstance;
+	instanceTickTime[pNewInstance] = 0;
 
 	debug(LOG_SAVE, "Created script engine %zu for player %d from %s", scripts.size() - 1, player, path.toUtf8().c_str());
 	return pNewInstance;
@@ -911,6 +1010,25 @@ std::vector<scripting_engine::timerNodeSnapshot> scripting_engine::debug_GetTime
 	return debug_timer_snapshot;
 }
 
+std::vector<scripting_engine::instancePerformanceSnapshot> scripting_engine::debug_GetPerformanceSnapshot() const
+{
+	std::vector<scripting_engine::instancePerformanceSnapshot> result;
+	for (auto *instance : scripts)
+	{
+		auto it = instanceLoads.find(instance);
+		if (it != instanceLoads.end())
+		{
+			result.push_back(it->second);
+		}
+	}
+	return result;
+}
+
+std::vector<scripting_engine::instancePerformanceSnapshot> scriptPerformanceSnapshot()
+{
+	return scripting_engine::instance().debug_GetPerformanceSnapshot();
+}
+
 void jsAutogameSpecific(const WzString &name, int player, AIDifficulty difficulty)
 {
 	wzapi::scripting_instance* instance = loadPlayerScript(name, player, difficulty);
@@ -2875,6 +2993,12 @@ void scripting_engine::logFunctionPerformance(wzapi::scripting_instance *instanc
 	}
 	m.time += ticks;
 	(*monitor)[function] = m;
+
+	auto &load = instanceLoads[instance];
+	load.instance = instance;
+	load.calls++;
+	load.time += ticks;
+	instanceTickTime[instance] += ticks;
 }
 
 // MARK: - DebugInterface
@@ -2887,6 +3011,10 @@ std::vector<scripting_engine::timerNodeSnapshot> scripting_engine::DebugInterfac
 {
 	return scripting_engine::instance().debug_GetTimersSnapshot();
 }
+std::vector<scripting_engine::instancePerformanceSnapshot> scripting_engine::DebugInterface::debug_GetPerformanceSnapshot() const
+{
+	return scripting_engine::instance().debug_GetPerformanceSnapshot();
+}
 std::vector<scripting_engine::LabelInfo> scripting_engine::DebugInterface::debug_GetLabelInfo() const
 {
 	return scripting_engine::instance().debug_GetLabelInfo();
@@ -29,6 +29,8 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <array>
+#include <queue>
+#include <functional>
 
 class WzString;
 struct BASE_OBJECT;
@@ -264,6 +266,7 @@ public:
 		int player;
 		int calls;
 		timerType type;
+		uint64_t sequence = 0; // insertion order; due timers run in this order
 		timerNode() : instance(nullptr), baseobjtype(OBJ_NUM_TYPES), additionalTimerFuncParam(nullptr) {}
 		timerNode(wzapi::scripting_instance* caller, const TimerFunc& func, const std::string& timerName, int plr, int frame, std::unique_ptr<timerAdditionalData> additionalParam = nullptr);
 		~timerNode();
@@ -289,12 +292,26 @@ private:
 	typedef std::map<wzapi::scripting_instance *, GROUPMAP *> ENGINEMAP;
 	ENGINEMAP groups;
 
-	/// List of timer events for scripts. Before running them, we sort the list then run as many as we have time for.
-	/// In this way, we implement load balancing of events and keep frame rates tidy for users. Since scripts run on the
-	/// host, we do not need to worry about each peer simulating the world differently.
+	/// List of timer events for scripts, in insertion order. This is the authoritative set of timers (and what gets saved).
 	std::list<std::shared_ptr<timerNode>> timers;
 	uniqueTimerID lastTimerID = 0;
 	std::unordered_map<uniqueTimerID, std::list<std::shared_ptr<timerNode>>::iterator> timerIDMap; // a map from uniqueTimerID -> entry in the timers list
+
+	/// Min-heap of pending timer invocations keyed by frameTime, so each tick only touches timers that are due.
+	/// Entries are not removed when their timer is; stale entries are skipped when popped.
+	struct timerQueueEntry
+	{
+		int frameTime;
+		uint64_t sequence;
+		std::weak_ptr<timerNode> node;
+		bool operator> (const timerQueueEntry &rhs) const
+		{
+			return (frameTime != rhs.frameTime) ? (frameTime > rhs.frameTime) : (sequence > rhs.sequence);
+		}
+	};
+	std::priority_queue<timerQueueEntry, std::vector<timerQueueEntry>, std::greater<timerQueueEntry>> timerQueue;
+	std::vector<uniqueTimerID> finishedTimerIDs; // oneshot timers that have run, removed at the start of the next update
+	uint64_t lastTimerSequence = 0;
 private:
 	scripting_engine() { }
 public:
@@ -373,6 +390,7 @@ private:
 	uniqueTimerID getNextAvailableTimerID();
 	// internal-only function that adds a Timer node (used for restoring saved games)
 	void addTimerNode(std::shared_ptr<timerNode>&& node);
+	void scheduleTimerNode(const std::shared_ptr<timerNode>& node);
 
 // MARK: triggering events (from wz game code)
 public:
@@ -473,6 +491,18 @@ public:
 		}
 	};
 
+	/// Accumulated script execution time of one scripting instance (all events and timers)
+	struct instancePerformanceSnapshot
+	{
+		wzapi::scripting_instance* instance = nullptr;
+		uint64_t calls = 0;
+		uint64_t time = 0;			///< total time spent in the instance (usec)
+		uint32_t lastTickTime = 0;		///< time spent during the last game tick (usec)
+		uint32_t worstTickTime = 0;		///< worst time spent during a single game tick (usec)
+		uint32_t worstTickGameTime = 0;	///< gameTime at which worstTickTime happened
+		uint32_t ticksOverBudget = 0;	///< game ticks in which the instance exceeded its time budget
+	};
+
 	struct LabelInfo
 	{
 		WzString label;
@@ -490,6 +520,7 @@ public:
 	public:
 		std::unordered_map<wzapi::scripting_instance *, nlohmann::json> debug_GetGlobalsSnapshot() const;
 		std::vector<scripting_engine::timerNodeSnapshot> debug_GetTimersSnapshot() const;
+		std::vector<scripting_engine::instancePerformanceSnapshot> debug_GetPerformanceSnapshot() const;
 		std::vector<scripting_engine::LabelInfo> debug_GetLabelInfo() const;
 		/// Show all labels or all currently active labels
 		void markAllLabels(bool only_active);
@@ -499,9 +530,11 @@ public:
 
 protected:
 	friend void jsShowDebug();
+	friend std::vector<scripting_engine::instancePerformanceSnapshot> scriptPerformanceSnapshot();
 
 	std::unordered_map<wzapi::scripting_instance *, nlohmann::json> debug_GetGlobalsSnapshot() const;
 	std::vector<scripting_engine::timerNodeSnapshot> debug_GetTimersSnapshot() const;
+	std::vector<scripting_engine::instancePerformanceSnapshot> debug_GetPerformanceSnapshot() const;
 	std::vector<scripting_engine::LabelInfo> debug_GetLabelInfo() const;
 
 	/// Show all labels or all currently active labels
@@ -524,4 +557,7 @@ private:
 /// Clear all map markers (used by label marking, for instance)
 void clearMarks();
 
+/// Accumulated execution time of each running script instance
+std::vector<scripting_engine::instancePerformanceSnapshot> scriptPerformanceSnapshot();
+
 #endif
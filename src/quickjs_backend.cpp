@@ -80,6 +80,7 @@
 #include "lib/framework/file.h"
 #include <unordered_map>
 #include <limits>
+#include <deque>
 
 #if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8
 #pragma GCC diagnostic push
@@ -152,6 +153,13 @@ bool QuickJS_EnumerateObjectProperties(JSContext *ctx, JSValue obj, const std::f
 class quickjs_scripting_instance;
 static std::map<JSContext*, quickjs_scripting_instance *> engineToInstanceMap;
 
+/// A script function found to handle an event (the function value must be freed after the call)
+struct JSEventHandler
+{
+	const std::string *name;
+	JSValue func;
+};
+
 static void QJSRuntimeFree_LeakHandler_Error(const char* msg)
 {
 	debug(LOG_ERROR, "QuickJS FreeRuntime leak: %s", msg);
@@ -191,6 +199,20 @@ public:
 
 		debug(LOG_INFO, "Destroying [%d]:%s/%s", player(), scriptPath().c_str(), scriptName().c_str());
 
+		for (const auto &it : literalAtoms)
+		{
+			JS_FreeAtom(ctx, it.second);
+		}
+		literalAtoms.clear();
+		for (const auto &it : eventHandlerAtoms)
+		{
+			for (const auto &entry : it.second)
+			{
+				JS_FreeAtom(ctx, entry.atom);
+			}
+		}
+		eventHandlerAtoms.clear();
+
 		if (!(JS_IsUninitialized(compiledScriptObj)))
 		{
 			JS_FreeValue(ctx, compiledScriptObj);
@@ -275,6 +297,68 @@ public: // temporary
 	std::vector<std::string> eventNamespaces;
 	JSValue Get_Global_Obj() const { return global_obj; }
 
+	/// Atom for a property name that is a string literal, created on first use and kept until the context is destroyed.
+	/// The conv* functions define dozens of properties on every game object they return, this saves a JS_NewAtom / JS_FreeAtom for each.
+	JSAtom literalAtom(const char *literal)
+	{
+		auto it = literalAtoms.find(literal);
+		if (it != literalAtoms.end())
+		{
+			return it->second;
+		}
+		JSAtom atom = JS_NewAtom(ctx, literal);
+		literalAtoms.emplace(literal, atom);
+		return atom;
+	}
+
+	/// The functions the script currently defines to handle an event: one per registered namespace, then the bare name
+	/// (the order callFunction() uses). Looked up on every dispatch (scripts may (re)define globals at any time), but
+	/// without building any strings, so that events nobody listens to skip converting their arguments to JS objects entirely.
+	void getEventHandlers(const char *eventName, std::vector<JSEventHandler> &handlers)
+	{
+		std::deque<EventHandlerAtom> &atoms = eventHandlerAtoms[eventName];
+		if (atoms.empty())
+		{
+			atoms.push_back(EventHandlerAtom{JS_NewAtom(ctx, eventName), eventName});
+		}
+		// namespaces are only ever appended, see js_namespace()
+		while (atoms.size() < eventNamespaces.size() + 1)
+		{
+			std::string funcName = eventNamespaces[atoms.size() - 1] + eventName;
+			JSAtom atom = JS_NewAtom(ctx, funcName.c_str());
+			atoms.push_back(EventHandlerAtom{atom, std::move(funcName)});
+		}
+		auto addIfFunction = [this, &handlers](const EventHandlerAtom &entry) {
+			JSValue value = JS_GetProperty(ctx, global_obj, entry.atom);
+			if (JS_IsFunction(ctx, value))
+			{
+				handlers.push_back(JSEventHandler{&entry.name, value});
+			}
+			else
+			{
+				JS_FreeValue(ctx, value);
+			}
+		};
+		for (size_t i = 1; i < atoms.size(); ++i)
+		{
+			addIfFunction(atoms[i]);
+		}
+		addIfFunction(atoms[0]);
+	}
+
+private:
+	struct EventHandlerAtom
+	{
+		JSAtom atom;
+		std::string name;
+	};
+
+	/// Keyed by the address of the literal
+	std::unordered_map<const char *, JSAtom> literalAtoms;
+	/// Keyed by the address of the event name literal: the bare name, followed by one per entry in eventNamespaces
+	/// (a deque, so that JSEventHandler::name stays valid if a handler registers a namespace)
+	std::unordered_map<const char *, std::deque<EventHandlerAtom>> eventHandlerAtoms;
+
 public:
 	// MARK: General events
 
@@ -754,6 +838,8 @@ int JS_DeletePropertyStr(JSContext *ctx, JSValueConst this_obj,
 JSValue convDroid(const DROID *psDroid, JSContext *ctx);
 JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx);
 JSValue convObj(const BASE_OBJECT *psObj, JSContext *ctx);
+class QuickJS_LiteralProperties;
+static JSValue convObj(const BASE_OBJECT *psObj, JSContext *ctx, QuickJS_LiteralProperties &props);
 JSValue convFeature(const FEATURE *psFeature, JSContext *ctx);
 JSValue convMax(const BASE_OBJECT *psObj, JSContext *ctx);
 JSValue convTemplate(const DROID_TEMPLATE *psTemplate, JSContext *ctx);
@@ -767,6 +853,29 @@ static int QuickJS_DefinePropertyValue(JSContext *ctx, JSValueConst this_obj, co
 	return ret;
 }
 
+// Defines properties whose names are string literals, using the atoms cached by the instance (see literalAtom())
+class QuickJS_LiteralProperties
+{
+public:
+	explicit QuickJS_LiteralProperties(JSContext *ctx)
+	: ctx(ctx)
+	, instance(engineToInstanceMap.at(ctx))
+	{ }
+
+	// Takes the name as an array reference, so that only string literals (not pointers to other strings) compile
+	template <size_t N>
+	int define(JSValueConst this_obj, const char (&literal)[N], JSValue val, int flags)
+	{
+		return JS_DefinePropertyValue(ctx, this_obj, instance->literalAtom(literal), val, flags);
+	}
+
+	quickjs_scripting_instance *getInstance() const { return instance; }
+
+private:
+	JSContext *ctx;
+	quickjs_scripting_instance *instance;
+};
+
 //;; ## Research
 //;;
 //;; Describes a research item. The following properties are defined:
@@ -786,9 +895,10 @@ JSValue convResearch(const RESEARCH *psResearch, JSContext *ctx, int player)
 	{
 		return JS_NULL;
 	}
+	QuickJS_LiteralProperties props(ctx);
 	JSValue value = JS_NewObject(ctx);
-	QuickJS_DefinePropertyValue(ctx, value, "power", JS_NewInt32(ctx, (int)psResearch->researchPower), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "points", JS_NewInt32(ctx, (int)psResearch->researchPoints), JS_PROP_ENUMERABLE);
+	props.define(value, "power", JS_NewInt32(ctx, (int)psResearch->researchPower), JS_PROP_ENUMERABLE);
+	props.define(value, "points", JS_NewInt32(ctx, (int)psResearch->researchPoints), JS_PROP_ENUMERABLE);
 	bool started = false;
 	for (int i = 0; i < game.maxPlayers; i++)
 	{
@@ -798,13 +908,13 @@ JSValue convResearch(const RESEARCH *psResearch, JSContext *ctx, int player)
 			started = started || (bits & STARTED_RESEARCH) || (bits & STARTED_RESEARCH_PENDING) || (bits & RESBITS_PENDING_ONLY);
 		}
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "started", JS_NewBool(ctx, started), JS_PROP_ENUMERABLE); // including whether an ally has started it
-	QuickJS_DefinePropertyValue(ctx, value, "done", JS_NewBool(ctx, IsResearchCompleted(&asPlayerResList[player][psResearch->index])), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "fullname", JS_NewString(ctx, psResearch->name.toUtf8().c_str()), JS_PROP_ENUMERABLE); // temporary
-	QuickJS_DefinePropertyValue(ctx, value, "name", JS_NewString(ctx, psResearch->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain fullname
-	QuickJS_DefinePropertyValue(ctx, value, "id", JS_NewString(ctx, psResearch->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "type", JS_NewInt32(ctx, SCRIPT_RESEARCH), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "results", mapJsonToQuickJSValue(ctx, psResearch->results, JS_PROP_ENUMERABLE), JS_PROP_ENUMERABLE);
+	props.define(value, "started", JS_NewBool(ctx, started), JS_PROP_ENUMERABLE); // including whether an ally has started it
+	props.define(value, "done", JS_NewBool(ctx, IsResearchCompleted(&asPlayerResList[player][psResearch->index])), JS_PROP_ENUMERABLE);
+	props.define(value, "fullname", JS_NewString(ctx, psResearch->name.toUtf8().c_str()), JS_PROP_ENUMERABLE); // temporary
+	props.define(value, "name", JS_NewString(ctx, psResearch->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain fullname
+	props.define(value, "id", JS_NewString(ctx, psResearch->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "type", JS_NewInt32(ctx, SCRIPT_RESEARCH), JS_PROP_ENUMERABLE);
+	props.define(value, "results", mapJsonToQuickJSValue(ctx, psResearch->results, JS_PROP_ENUMERABLE), JS_PROP_ENUMERABLE);
 	return value;
 }
 
@@ -832,6 +942,7 @@ JSValue convResearch(const RESEARCH *psResearch, JSContext *ctx, int player)
 //;;
 JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx)
 {
+	QuickJS_LiteralProperties props(ctx);
 	bool aa = false;
 	bool ga = false;
 	bool indirect = false;
@@ -847,18 +958,18 @@ JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx)
 			range = MAX(proj_GetLongRange(*psWeap, psStruct->player), range);
 		}
 	}
-	JSValue value = convObj(psStruct, ctx);
-	QuickJS_DefinePropertyValue(ctx, value, "isCB", JS_NewBool(ctx, structCBSensor(psStruct)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isSensor", JS_NewBool(ctx, structStandardSensor(psStruct)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitAir", JS_NewBool(ctx, aa), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitGround", JS_NewBool(ctx, ga), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "hasIndirect", JS_NewBool(ctx, indirect), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isRadarDetector", JS_NewBool(ctx, objRadarDetector(psStruct)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "range", JS_NewInt32(ctx, range), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "status", JS_NewInt32(ctx, (int)psStruct->status), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "health", JS_NewInt32(ctx, 100 * psStruct->body / MAX(1, psStruct->structureBody())), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "cost", JS_NewInt32(ctx, psStruct->pStructureType->powerToBuild), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "direction", JS_NewInt32(ctx, static_cast<int32_t>(UNDEG(psStruct->rot.direction))), JS_PROP_ENUMERABLE);
+	JSValue value = convObj(psStruct, ctx, props);
+	props.define(value, "isCB", JS_NewBool(ctx, structCBSensor(psStruct)), JS_PROP_ENUMERABLE);
+	props.define(value, "isSensor", JS_NewBool(ctx, structStandardSensor(psStruct)), JS_PROP_ENUMERABLE);
+	props.define(value, "canHitAir", JS_NewBool(ctx, aa), JS_PROP_ENUMERABLE);
+	props.define(value, "canHitGround", JS_NewBool(ctx, ga), JS_PROP_ENUMERABLE);
+	props.define(value, "hasIndirect", JS_NewBool(ctx, indirect), JS_PROP_ENUMERABLE);
+	props.define(value, "isRadarDetector", JS_NewBool(ctx, objRadarDetector(psStruct)), JS_PROP_ENUMERABLE);
+	props.define(value, "range", JS_NewInt32(ctx, range), JS_PROP_ENUMERABLE);
+	props.define(value, "status", JS_NewInt32(ctx, (int)psStruct->status), JS_PROP_ENUMERABLE);
+	props.define(value, "health", JS_NewInt32(ctx, 100 * psStruct->body / MAX(1, psStruct->structureBody())), JS_PROP_ENUMERABLE);
+	props.define(value, "cost", JS_NewInt32(ctx, psStruct->pStructureType->powerToBuild), JS_PROP_ENUMERABLE);
+	props.define(value, "direction", JS_NewInt32(ctx, static_cast<int32_t>(UNDEG(psStruct->rot.direction))), JS_PROP_ENUMERABLE);
 	int stattype = 0;
 	switch (psStruct->pStructureType->type) // don't bleed our source insanities into the scripting world
 	{
@@ -875,30 +986,30 @@ JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx)
 		stattype = (int)psStruct->pStructureType->type;
 		break;
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "stattype", JS_NewInt32(ctx, stattype), JS_PROP_ENUMERABLE);
+	props.define(value, "stattype", JS_NewInt32(ctx, stattype), JS_PROP_ENUMERABLE);
 	if (psStruct->pStructureType->type == REF_FACTORY || psStruct->pStructureType->type == REF_CYBORG_FACTORY
 	    || psStruct->pStructureType->type == REF_VTOL_FACTORY
 	    || psStruct->pStructureType->type == REF_RESEARCH
 	    || psStruct->pStructureType->type == REF_POWER_GEN)
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "modules", JS_NewUint32(ctx, psStruct->capacity), JS_PROP_ENUMERABLE);
+		props.define(value, "modules", JS_NewUint32(ctx, psStruct->capacity), JS_PROP_ENUMERABLE);
 	}
 	else
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "modules", JS_NULL, JS_PROP_ENUMERABLE);
+		props.define(value, "modules", JS_NULL, JS_PROP_ENUMERABLE);
 	}
 	JSValue weaponlist = JS_NewArray(ctx);
 	for (int j = 0; j < psStruct->numWeaps; j++)
 	{
 		JSValue weapon = JS_NewObject(ctx);
 		const WEAPON_STATS *psStats = psStruct->getWeaponStats(j);
-		QuickJS_DefinePropertyValue(ctx, weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
-		QuickJS_DefinePropertyValue(ctx, weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "lastFired", JS_NewUint32(ctx, psStruct->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
+		props.define(weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+		props.define(weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
+		props.define(weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+		props.define(weapon, "lastFired", JS_NewUint32(ctx, psStruct->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
 		JS_DefinePropertyValueUint32(ctx, weaponlist, j, weapon, JS_PROP_ENUMERABLE);
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
+	props.define(value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
 	return value;
 }
 
@@ -912,11 +1023,12 @@ JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx)
 //;;
 JSValue convFeature(const FEATURE *psFeature, JSContext *ctx)
 {
-	JSValue value = convObj(psFeature, ctx);
+	QuickJS_LiteralProperties props(ctx);
+	JSValue value = convObj(psFeature, ctx, props);
 	const FEATURE_STATS *psStats = psFeature->psStats;
-	QuickJS_DefinePropertyValue(ctx, value, "health", JS_NewUint32(ctx, 100 * psStats->body / MAX(1, psFeature->body)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "damageable", JS_NewBool(ctx, psStats->damageable), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "stattype", JS_NewInt32(ctx, psStats->subType), JS_PROP_ENUMERABLE);
+	props.define(value, "health", JS_NewUint32(ctx, 100 * psStats->body / MAX(1, psFeature->body)), JS_PROP_ENUMERABLE);
+	props.define(value, "damageable", JS_NewBool(ctx, psStats->damageable), JS_PROP_ENUMERABLE);
+	props.define(value, "stattype", JS_NewInt32(ctx, psStats->subType), JS_PROP_ENUMERABLE);
 	return value;
 }
 
@@ -984,6 +1096,7 @@ JSValue convFeature(const FEATURE *psFeature, JSContext *ctx)
 //;;
 JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 {
+	QuickJS_LiteralProperties props(ctx);
 	bool aa = false;
 	bool ga = false;
 	bool indirect = false;
@@ -1003,19 +1116,19 @@ JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 		}
 	}
 	DROID_TYPE type = psDroid->droidType;
-	JSValue value = convObj(psDroid, ctx);
-	QuickJS_DefinePropertyValue(ctx, value, "action", JS_NewInt32(ctx, (int)psDroid->action), JS_PROP_ENUMERABLE);
+	JSValue value = convObj(psDroid, ctx, props);
+	props.define(value, "action", JS_NewInt32(ctx, (int)psDroid->action), JS_PROP_ENUMERABLE);
 	if (range >= 0)
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "range", JS_NewInt32(ctx, range), JS_PROP_ENUMERABLE);
+		props.define(value, "range", JS_NewInt32(ctx, range), JS_PROP_ENUMERABLE);
 	}
 	else
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "range", JS_NULL, JS_PROP_ENUMERABLE);
+		props.define(value, "range", JS_NULL, JS_PROP_ENUMERABLE);
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "order", JS_NewInt32(ctx, (int)psDroid->order.type), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "cost", JS_NewUint32(ctx, calcDroidPower(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "hasIndirect", JS_NewBool(ctx, indirect), JS_PROP_ENUMERABLE);
+	props.define(value, "order", JS_NewInt32(ctx, (int)psDroid->order.type), JS_PROP_ENUMERABLE);
+	props.define(value, "cost", JS_NewUint32(ctx, calcDroidPower(psDroid)), JS_PROP_ENUMERABLE);
+	props.define(value, "hasIndirect", JS_NewBool(ctx, indirect), JS_PROP_ENUMERABLE);
 	switch (psDroid->droidType) // hide some engine craziness
 	{
 	case DROID_CYBORG_CONSTRUCT:
@@ -1029,26 +1142,26 @@ JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 	default:
 		break;
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "bodySize", JS_NewInt32(ctx, psBodyStats->size), JS_PROP_ENUMERABLE);
+	props.define(value, "bodySize", JS_NewInt32(ctx, psBodyStats->size), JS_PROP_ENUMERABLE);
 	if (psDroid->isTransporter())
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "cargoCapacity", JS_NewInt32(ctx, TRANSPORTER_CAPACITY), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, value, "cargoLeft", JS_NewInt32(ctx, calcRemainingCapacity(psDroid)), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, value, "cargoCount", JS_NewUint32(ctx, psDroid->psGroup != nullptr? psDroid->psGroup->getNumMembers() : 0), JS_PROP_ENUMERABLE);
+		props.define(value, "cargoCapacity", JS_NewInt32(ctx, TRANSPORTER_CAPACITY), JS_PROP_ENUMERABLE);
+		props.define(value, "cargoLeft", JS_NewInt32(ctx, calcRemainingCapacity(psDroid)), JS_PROP_ENUMERABLE);
+		props.define(value, "cargoCount", JS_NewUint32(ctx, psDroid->psGroup != nullptr? psDroid->psGroup->getNumMembers() : 0), JS_PROP_ENUMERABLE);
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "isRadarDetector", JS_NewBool(ctx, objRadarDetector(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isCB", JS_NewBool(ctx, cbSensorDroid(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isSensor", JS_NewBool(ctx, standardSensorDroid(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitAir", JS_NewBool(ctx, aa), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitGround", JS_NewBool(ctx, ga), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isVTOL", JS_NewBool(ctx, psDroid->isVtol()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "droidType", JS_NewInt32(ctx, (int)type), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "experience", JS_NewFloat64(ctx, (double)psDroid->experience / 65536.0), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "health", JS_NewFloat64(ctx, 100.0 / (double)psDroid->originalBody * (double)psDroid->body), JS_PROP_ENUMERABLE);
-
-	QuickJS_DefinePropertyValue(ctx, value, "body", JS_NewString(ctx, psDroid->getBodyStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "propulsion", JS_NewString(ctx, psDroid->getPropulsionStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "armed", JS_NewFloat64(ctx, 0.0), JS_PROP_ENUMERABLE); // deprecated!
+	props.define(value, "isRadarDetector", JS_NewBool(ctx, objRadarDetector(psDroid)), JS_PROP_ENUMERABLE);
+	props.define(value, "isCB", JS_NewBool(ctx, cbSensorDroid(psDroid)), JS_PROP_ENUMERABLE);
+	props.define(value, "isSensor", JS_NewBool(ctx, standardSensorDroid(psDroid)), JS_PROP_ENUMERABLE);
+	props.define(value, "canHitAir", JS_NewBool(ctx, aa), JS_PROP_ENUMERABLE);
+	props.define(value, "canHitGround", JS_NewBool(ctx, ga), JS_PROP_ENUMERABLE);
+	props.define(value, "isVTOL", JS_NewBool(ctx, psDroid->isVtol()), JS_PROP_ENUMERABLE);
+	props.define(value, "droidType", JS_NewInt32(ctx, (int)type), JS_PROP_ENUMERABLE);
+	props.define(value, "experience", JS_NewFloat64(ctx, (double)psDroid->experience / 65536.0), JS_PROP_ENUMERABLE);
+	props.define(value, "health", JS_NewFloat64(ctx, 100.0 / (double)psDroid->originalBody * (double)psDroid->body), JS_PROP_ENUMERABLE);
+
+	props.define(value, "body", JS_NewString(ctx, psBodyStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "propulsion", JS_NewString(ctx, psDroid->getPropulsionStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "armed", JS_NewFloat64(ctx, 0.0), JS_PROP_ENUMERABLE); // deprecated!
 
 	JSValue weaponlist = JS_NewArray(ctx);
 	for (int j = 0; j < psDroid->numWeaps; j++)
@@ -1056,15 +1169,15 @@ JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 		int armed = droidReloadBar(psDroid, &psDroid->asWeaps[j], j);
 		JSValue weapon = JS_NewObject(ctx);
 		const WEAPON_STATS *psStats = psDroid->getWeaponStats(j);
-		QuickJS_DefinePropertyValue(ctx, weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
-		QuickJS_DefinePropertyValue(ctx, weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "lastFired", JS_NewUint32(ctx, psDroid->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "armed", JS_NewInt32(ctx, armed), JS_PROP_ENUMERABLE);
+		props.define(weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+		props.define(weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
+		props.define(weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+		props.define(weapon, "lastFired", JS_NewUint32(ctx, psDroid->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
+		props.define(weapon, "armed", JS_NewInt32(ctx, armed), JS_PROP_ENUMERABLE);
 		JS_DefinePropertyValueUint32(ctx, weaponlist, j, weapon, JS_PROP_ENUMERABLE);
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "cargoSize", JS_NewInt32(ctx, transporterSpaceRequired(psDroid)), JS_PROP_ENUMERABLE);
+	props.define(value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
+	props.define(value, "cargoSize", JS_NewInt32(ctx, transporterSpaceRequired(psDroid)), JS_PROP_ENUMERABLE);
 	return value;
 }
 
@@ -1089,29 +1202,35 @@ JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 //;; * ```born``` The game time at which this object was produced or came into the world. (3.2+ only)
 //;;
 JSValue convObj(const BASE_OBJECT *psObj, JSContext *ctx)
+{
+	QuickJS_LiteralProperties props(ctx);
+	return convObj(psObj, ctx, props);
+}
+
+static JSValue convObj(const BASE_OBJECT *psObj, JSContext *ctx, QuickJS_LiteralProperties &props)
 {
 	JSValue value = JS_NewObject(ctx);
 	ASSERT_OR_RETURN(value, psObj, "No object for conversion");
-	QuickJS_DefinePropertyValue(ctx, value, "id", JS_NewUint32(ctx, psObj->id), 0);
-	QuickJS_DefinePropertyValue(ctx, value, "x", JS_NewInt32(ctx, map_coord(psObj->pos.x)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "y", JS_NewInt32(ctx, map_coord(psObj->pos.y)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "z", JS_NewInt32(ctx, map_coord(psObj->pos.z)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "player", JS_NewUint32(ctx, psObj->player), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "armour", JS_NewInt32(ctx, objArmour(psObj, WC_KINETIC)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "thermal", JS_NewInt32(ctx, objArmour(psObj, WC_HEAT)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "type", JS_NewInt32(ctx, psObj->type), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "selected", JS_NewUint32(ctx, psObj->selected), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "name", JS_NewString(ctx, objInfo(psObj)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "born", JS_NewUint32(ctx, psObj->born), JS_PROP_ENUMERABLE);
-	scripting_engine::GROUPMAP *psMap = scripting_engine::instance().getGroupMap(engineToInstanceMap.at(ctx));
+	props.define(value, "id", JS_NewUint32(ctx, psObj->id), 0);
+	props.define(value, "x", JS_NewInt32(ctx, map_coord(psObj->pos.x)), JS_PROP_ENUMERABLE);
+	props.define(value, "y", JS_NewInt32(ctx, map_coord(psObj->pos.y)), JS_PROP_ENUMERABLE);
+	props.define(value, "z", JS_NewInt32(ctx, map_coord(psObj->pos.z)), JS_PROP_ENUMERABLE);
+	props.define(value, "player", JS_NewUint32(ctx, psObj->player), JS_PROP_ENUMERABLE);
+	props.define(value, "armour", JS_NewInt32(ctx, objArmour(psObj, WC_KINETIC)), JS_PROP_ENUMERABLE);
+	props.define(value, "thermal", JS_NewInt32(ctx, objArmour(psObj, WC_HEAT)), JS_PROP_ENUMERABLE);
+	props.define(value, "type", JS_NewInt32(ctx, psObj->type), JS_PROP_ENUMERABLE);
+	props.define(value, "selected", JS_NewUint32(ctx, psObj->selected), JS_PROP_ENUMERABLE);
+	props.define(value, "name", JS_NewString(ctx, objInfo(psObj)), JS_PROP_ENUMERABLE);
+	props.define(value, "born", JS_NewUint32(ctx, psObj->born), JS_PROP_ENUMERABLE);
+	scripting_engine::GROUPMAP *psMap = scripting_engine::instance().getGroupMap(props.getInstance());
 	if (psMap != nullptr && psMap->map().count(psObj) > 0) // FIXME:
 	{
 		int group = psMap->map().at(psObj); // FIXME:
-		QuickJS_DefinePropertyValue(ctx, value, "group", JS_NewInt32(ctx, group), JS_PROP_ENUMERABLE);
+		props.define(value, "group", JS_NewInt32(ctx, group), JS_PROP_ENUMERABLE);
 	}
 	else
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "group", JS_NULL, JS_PROP_ENUMERABLE);
+		props.define(value, "group", JS_NULL, JS_PROP_ENUMERABLE);
 	}
 	return value;
 }
@@ -1136,26 +1255,27 @@ JSValue convTemplate(const DROID_TEMPLATE *psTempl, JSContext *ctx)
 {
 	JSValue value = JS_NewObject(ctx);
 	ASSERT_OR_RETURN(value, psTempl, "No object for conversion");
-	QuickJS_DefinePropertyValue(ctx, value, "fullname", JS_NewString(ctx, psTempl->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "name", JS_NewString(ctx, psTempl->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "id", JS_NewString(ctx, psTempl->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "points", JS_NewUint32(ctx, calcTemplateBuild(psTempl)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "power", JS_NewUint32(ctx, calcTemplatePower(psTempl)), JS_PROP_ENUMERABLE); // deprecated, use cost below
-	QuickJS_DefinePropertyValue(ctx, value, "cost", JS_NewUint32(ctx, calcTemplatePower(psTempl)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "droidType", JS_NewInt32(ctx, psTempl->droidType), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "body", JS_NewString(ctx, psTempl->getBodyStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "propulsion", JS_NewString(ctx, psTempl->getPropulsionStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "brain", JS_NewString(ctx, psTempl->getBrainStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "repair", JS_NewString(ctx, psTempl->getRepairStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "ecm", JS_NewString(ctx, psTempl->getECMStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "sensor", JS_NewString(ctx, psTempl->getSensorStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "construct", JS_NewString(ctx, psTempl->getConstructStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	QuickJS_LiteralProperties props(ctx);
+	props.define(value, "fullname", JS_NewString(ctx, psTempl->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "name", JS_NewString(ctx, psTempl->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "id", JS_NewString(ctx, psTempl->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "points", JS_NewUint32(ctx, calcTemplateBuild(psTempl)), JS_PROP_ENUMERABLE);
+	props.define(value, "power", JS_NewUint32(ctx, calcTemplatePower(psTempl)), JS_PROP_ENUMERABLE); // deprecated, use cost below
+	props.define(value, "cost", JS_NewUint32(ctx, calcTemplatePower(psTempl)), JS_PROP_ENUMERABLE);
+	props.define(value, "droidType", JS_NewInt32(ctx, psTempl->droidType), JS_PROP_ENUMERABLE);
+	props.define(value, "body", JS_NewString(ctx, psTempl->getBodyStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "propulsion", JS_NewString(ctx, psTempl->getPropulsionStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "brain", JS_NewString(ctx, psTempl->getBrainStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "repair", JS_NewString(ctx, psTempl->getRepairStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "ecm", JS_NewString(ctx, psTempl->getECMStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "sensor", JS_NewString(ctx, psTempl->getSensorStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+	props.define(value, "construct", JS_NewString(ctx, psTempl->getConstructStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
 	JSValue weaponlist = JS_NewArray(ctx);
 	for (int j = 0; j < psTempl->numWeaps; j++)
 	{
 		JS_DefinePropertyValueUint32(ctx, weaponlist, j, JS_NewString(ctx, psTempl->getWeaponStats(j)->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
 	}
-	QuickJS_DefinePropertyValue(ctx, value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
+	props.define(value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
 	return value;
 }
 
@@ -1174,6 +1294,8 @@ JSValue convMax(const BASE_OBJECT *psObj, JSContext *ctx)
 	}
 }
 
+static JSValue callFunctionValue(JSContext *ctx, const std::string &function, JSValue value, std::vector<JSValue> &args);
+
 // Call a function by name
 static JSValue callFunction(JSContext *ctx, const std::string &function, std::vector<JSValue> &args, bool event = true)
 {
@@ -1204,6 +1326,13 @@ static JSValue callFunction(JSContext *ctx, const std::string &function, std::ve
 		return JS_FALSE; // ?? Shouldn't this be "undefined?"
 	}
 
+	return callFunctionValue(ctx, function, value, args);
+}
+
+// Call an already looked up function
+static JSValue callFunctionValue(JSContext *ctx, const std::string &function, JSValue value, std::vector<JSValue> &args)
+{
+	const auto instance = engineToInstanceMap.at(ctx);
 	JSValue result;
 	scripting_engine::instance().executeWithPerformanceMonitoring(instance, function, [ctx, &result, value, &args](){
 		result = JS_Call(ctx, value, JS_UNDEFINED, (int)args.size(), args.data());
@@ -2239,14 +2368,19 @@ static JSValue callFunction(JSContext *ctx, const std::string &function, std::ve
 		void append_value_list(std::vector<JSValue> &list, T t, JSContext *context) { list.push_back(box(std::forward<T>(t), context)); }
 
 		template <typename... Args>
-		bool wrap_event_handler__(const std::string &functionName, JSContext *context, Args&&... args)
+		bool wrap_event_handler__(std::vector<JSEventHandler> &handlers, JSContext *context, Args&&... args)
 		{
 			std::vector<JSValue> args_list;
 			using expander = int[];
 //			WZ_DECL_UNUSED int dummy[] = { 0, ((void) append_value_list(args_list, std::forward<Args>(args), engine),0)... };
 			// Left-most void to avoid `expression result unused [-Wunused-value]`
 			(void)expander{ 0, ((void) append_value_list(args_list, std::forward<Args>(args), context),0)... };
-			/*JSValue result =*/ callFunction(context, functionName, args_list);
+			for (const JSEventHandler &handler : handlers)
+			{
+				JSValue result = callFunctionValue(context, *handler.name, handler.func, args_list);
+				JS_FreeValue(context, result);
+				JS_FreeValue(context, handler.func);
+			}
 			std::for_each(args_list.begin(), args_list.end(), [context](JSValue& val) { JS_FreeValue(context, val); });
 			return true; //nlohmann::json(result.toVariant());
 		}
@@ -2289,12 +2423,18 @@ static JSValue callFunction(JSContext *ctx, const std::string &function, std::ve
 
 		#define IMPL_EVENT_HANDLER(fun, ...) \
 			bool quickjs_scripting_instance::handle_##fun(MAKE_PARAMS(__VA_ARGS__)) { \
-				return wrap_event_handler__(STRINGIFY(fun), ctx, MAKE_ARGS(__VA_ARGS__)); \
+				std::vector<JSEventHandler> handlers; \
+				getEventHandlers(STRINGIFY(fun), handlers); \
+				if (handlers.empty()) { return true; } \
+				return wrap_event_handler__(handlers, ctx, MAKE_ARGS(__VA_ARGS__)); \
 			}
 
 		#define IMPL_EVENT_HANDLER_NO_PARAMS(fun) \
 		bool quickjs_scripting_instance::handle_##fun() { \
-			return wrap_event_handler__(STRINGIFY(fun), ctx); \
+			std::vector<JSEventHandler> handlers; \
+			getEventHandlers(STRINGIFY(fun), handlers); \
+			if (handlers.empty()) { return true; } \
+			return wrap_event_handler__(handlers, ctx); \
 		}
 
 	}
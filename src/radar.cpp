@@ -19,6 +19,8 @@
 */
 #include <string.h>
 #include <cstdlib>
+#include <algorithm>
+#include <vector>
 
 #include "lib/framework/frame.h"
 #include "lib/framework/fixedpoint.h"
@@ -62,7 +64,7 @@
 #define HIT_NOTIFICATION	(GAME_TICKS_PER_SEC * 2)
 #define RADAR_FRAME_SKIP	10
 
-static void applyMinimapOverlay();
+static WzRect applyMinimapOverlay();
 
 bool bEnemyAllyRadarColor = false;     			/**< Enemy/ally radar color. */
 RADAR_DRAW_MODE	radarDrawMode = RADAR_MODE_DEFAULT;	/**< Current mini-map mode. */
@@ -73,6 +75,12 @@ static PIELIGHT		colRadarAlly, colRadarMe, colRadarEnemy;
 static PIELIGHT		tileColours[MAX_TILES];
 static iV_Image		radarBitmap;
 static UDWORD		*radarOverlayBuffer = nullptr;
+static UDWORD		*radarPrevOverlayBuffer = nullptr;	///< Overlay of the previous radar refresh, to find the pixels the objects moved away from
+static std::vector<PIELIGHT> radarTileBuffer;			///< Terrain colour of each radar pixel, before the object overlay is applied
+static std::vector<uint8_t> radarTileVisibility;		///< Visibility state each radar pixel's terrain colour was computed with
+static std::vector<uint8_t> radarPixelDirty;			///< Radar pixels whose terrain colour changed since the last refresh
+static std::vector<uint8_t> radarMapTileDirty;			///< Map tiles whose height / texture / lighting changed since the last refresh
+static bool		radarAllTilesDirty = true;
 static Vector3i		playerpos = {0, 0, 0};
 
 class RadarWidget : public WIDGET {
@@ -150,6 +158,9 @@ static uint8_t RadarZoom;
 static float RadarZoomMultiplier = 1.0f;
 static size_t radarBufferSize = 0;
 static int frameSkip = 0;
+static bool lastRadarRevealStatus = false;
+static RADAR_DRAW_MODE lastRadarDrawMode = NUM_RADAR_MODES;
+static int lastRadarScrollMinX = 0, lastRadarScrollMinY = 0, lastRadarScrollMaxX = 0, lastRadarScrollMaxY = 0;
 static UDWORD lastBlink = 0;
 static const UDWORD BLINK_INTERVAL = GAME_TICKS_PER_SEC / 1;
 static const UDWORD BLINK_HALF_INTERVAL = BLINK_INTERVAL / 2;
@@ -262,12 +273,22 @@ bool resizeRadar()
 	{
 		free(radarOverlayBuffer);
 	}
+	if (radarPrevOverlayBuffer)
+	{
+		free(radarPrevOverlayBuffer);
+	}
 	radarTexWidth = static_cast<size_t>(std::abs(scrollMaxX - scrollMinX));
 	radarTexHeight = static_cast<size_t>(std::abs(scrollMaxY - scrollMinY));
 	radarBufferSize = radarTexWidth * radarTexHeight * sizeof(UDWORD);
 	radarBitmap.allocate(radarTexWidth, radarTexHeight, 4, true);
 	radarOverlayBuffer = (uint32_t*)malloc(radarBufferSize);
 	memset(radarOverlayBuffer, 0, radarBufferSize);
+	radarPrevOverlayBuffer = (uint32_t*)malloc(radarBufferSize);
+	memset(radarPrevOverlayBuffer, 0, radarBufferSize);
+	radarTileBuffer.assign(radarTexWidth * radarTexHeight, WZCOL_BLACK);
+	radarTileVisibility.assign(radarTexWidth * radarTexHeight, 0);
+	radarPixelDirty.assign(radarTexWidth * radarTexHeight, 0);
+	radarMarkAllTilesDirty();
 	frameSkip = 0;
 	if (rotateRadar)
 	{
@@ -289,6 +310,13 @@ bool ShutdownRadar()
 	radarBitmap.clear();
 	free(radarOverlayBuffer);
 	radarOverlayBuffer = nullptr;
+	free(radarPrevOverlayBuffer);
+	radarPrevOverlayBuffer = nullptr;
+	radarTileBuffer = std::vector<PIELIGHT>();
+	radarTileVisibility = std::vector<uint8_t>();
+	radarPixelDirty = std::vector<uint8_t>();
+	radarMapTileDirty = std::vector<uint8_t>();
+	radarAllTilesDirty = true;
 	frameSkip = 0;
 	if (pRadarWidget)
 	{
@@ -378,8 +406,7 @@ void drawRadar()
 	{
 		DrawRadarTiles();
 		DrawRadarObjects();
-		applyMinimapOverlay();
-		pie_DownLoadRadar(radarBitmap);
+		pie_DownLoadRadar(radarBitmap, applyMinimapOverlay());
 		frameSkip = RADAR_FRAME_SKIP;
 	}
 	frameSkip--;
@@ -494,36 +521,88 @@ static PIELIGHT inline appliedRadarColour(RADAR_DRAW_MODE drawMode, MAPTILE *WTi
 	return WScr;
 }
 
-/** Draw the map tiles on the radar. */
+/** The visibility-dependent inputs of appliedRadarColour() for a tile, packed so that changes can be spotted cheaply. */
+static inline uint8_t radarTileVisibilityState(MAPTILE *psTile)
+{
+	return (TEST_TILE_VISIBLE_TO_SELECTEDPLAYER(psTile) ? 1 : 0) | (hasSensorOnTile(psTile, selectedPlayer) ? 2 : 0);
+}
+
+void radarMarkTileDirty(int x, int y)
+{
+	if (radarAllTilesDirty || x < 0 || y < 0 || x >= mapWidth || y >= mapHeight)
+	{
+		return;
+	}
+	if (radarMapTileDirty.size() != static_cast<size_t>(mapWidth) * static_cast<size_t>(mapHeight))
+	{
+		radarAllTilesDirty = true; // map changed size, everything gets redrawn anyway
+		return;
+	}
+	radarMapTileDirty[x + y * mapWidth] = 1;
+}
+
+void radarMarkAllTilesDirty()
+{
+	radarAllTilesDirty = true;
+}
+
+/** Draw the map tiles on the radar. Only tiles that changed since the last refresh are recalculated. */
 static void DrawRadarTiles()
 {
-	SDWORD	x, y;
-	size_t radarBufferSize2 = radarBitmap.size_in_bytes();
-	unsigned char* pRaderBuffer = radarBitmap.bmp_w();
+	const size_t radarTexCount = radarTexWidth * radarTexHeight;
+	ASSERT_OR_RETURN(, radarTileBuffer.size() == radarTexCount && radarTileVisibility.size() == radarTexCount && radarPixelDirty.size() == radarTexCount, "Radar tile buffers not allocated");
 
-	for (x = scrollMinX; x < scrollMaxX; x++)
+	// Changes that affect every tile
+	const bool revealStatus = getRevealStatus();
+	if (revealStatus != lastRadarRevealStatus || radarDrawMode != lastRadarDrawMode
+	    || scrollMinX != lastRadarScrollMinX || scrollMinY != lastRadarScrollMinY || scrollMaxX != lastRadarScrollMaxX || scrollMaxY != lastRadarScrollMaxY)
+	{
+		lastRadarRevealStatus = revealStatus;
+		lastRadarDrawMode = radarDrawMode;
+		lastRadarScrollMinX = scrollMinX;
+		lastRadarScrollMinY = scrollMinY;
+		lastRadarScrollMaxX = scrollMaxX;
+		lastRadarScrollMaxY = scrollMaxY;
+		radarAllTilesDirty = true;
+	}
+	const size_t mapTileCount = static_cast<size_t>(mapWidth) * static_cast<size_t>(mapHeight);
+	if (radarMapTileDirty.size() != mapTileCount)
 	{
-		for (y = scrollMinY; y < scrollMaxY; y++)
+		radarMapTileDirty.assign(mapTileCount, 0);
+		radarAllTilesDirty = true;
+	}
+
+	for (SDWORD y = scrollMinY; y < scrollMaxY; y++)
+	{
+		for (SDWORD x = scrollMinX; x < scrollMaxX; x++)
 		{
 			MAPTILE	*psTile = mapTile(x, y);
-			size_t pixelStartPos = (radarTexWidth * (y - scrollMinY) + (x - scrollMinX)) * 4;
+			size_t pos = radarTexWidth * (y - scrollMinY) + (x - scrollMinX);
+			size_t mapPos = x + y * mapWidth;
 
-			ASSERT(pixelStartPos < radarBufferSize2, "Buffer overrun");
+			ASSERT(pos < radarTexCount, "Buffer overrun");
+			// Visibility bits are updated from all over the game logic, so compare them instead of tracking every write
+			const uint8_t visibility = radarTileVisibilityState(psTile);
+			if (!radarAllTilesDirty && !radarMapTileDirty[mapPos] && radarTileVisibility[pos] == visibility)
+			{
+				continue;
+			}
+			radarTileVisibility[pos] = visibility;
+			radarMapTileDirty[mapPos] = 0;
+			radarPixelDirty[pos] = 1;
 			if (y == scrollMinY || x == scrollMinX || y == scrollMaxY - 1 || x == scrollMaxX - 1)
 			{
-				pRaderBuffer[pixelStartPos] = WZCOL_BLACK.byte.r;
-				pRaderBuffer[pixelStartPos + 1] = WZCOL_BLACK.byte.g;
-				pRaderBuffer[pixelStartPos + 2] = WZCOL_BLACK.byte.b;
-				pRaderBuffer[pixelStartPos + 3] = WZCOL_BLACK.byte.a;
+				radarTileBuffer[pos] = WZCOL_BLACK;
 				continue;
 			}
-			auto radarColor = appliedRadarColour(radarDrawMode, psTile);
-			pRaderBuffer[pixelStartPos] = radarColor.byte.r;
-			pRaderBuffer[pixelStartPos + 1] = radarColor.byte.g;
-			pRaderBuffer[pixelStartPos + 2] = radarColor.byte.b;
-			pRaderBuffer[pixelStartPos + 3] = radarColor.byte.a;
+			radarTileBuffer[pos] = appliedRadarColour(radarDrawMode, psTile);
 		}
 	}
+	if (radarAllTilesDirty)
+	{
+		std::fill(radarMapTileDirty.begin(), radarMapTileDirty.end(), 0);
+		radarAllTilesDirty = false;
+	}
 }
 
 /** Draw the droids and structure positions on the radar. */
@@ -532,6 +611,7 @@ static void DrawRadarObjects()
 	UBYTE				clan;
 	PIELIGHT			playerCol;
 	PIELIGHT			flashCol;
+	std::swap(radarOverlayBuffer, radarPrevOverlayBuffer);
 	memset(radarOverlayBuffer, 0, radarBufferSize);
 	bool blinkState = (gameTime - lastBlink) / BLINK_HALF_INTERVAL;
 
@@ -656,26 +736,47 @@ static void DrawRadarObjects()
 		lastBlink = gameTime;
 }
 
-static void applyMinimapOverlay()
+/** Combine the terrain colours with the object overlay. Only pixels whose terrain or overlay changed are rewritten.
+ * Returns the area of the radar bitmap that changed. */
+static WzRect applyMinimapOverlay()
 {
 	size_t radarTexCount = radarTexWidth * radarTexHeight;
 	size_t radarBufferSize2 = radarBitmap.size_in_bytes();
 	unsigned char* pRaderBuffer = radarBitmap.bmp_w();
+	ASSERT_OR_RETURN(WzRect(), radarTileBuffer.size() == radarTexCount && radarPixelDirty.size() == radarTexCount, "Radar tile buffers not allocated");
 	ASSERT(radarTexCount * static_cast<size_t>(radarBitmap.channels()) <= radarBufferSize2, "Buffer overrun");
 	ASSERT(radarTexCount * static_cast<size_t>(radarBitmap.channels()) <= radarBufferSize, "Buffer overrun");
+	size_t minX = radarTexWidth, minY = radarTexHeight, maxX = 0, maxY = 0;
 	for (size_t i = 0; i < radarTexCount; i++)
 	{
-		if (radarOverlayBuffer[i] == 0)
+		if (!radarPixelDirty[i] && radarOverlayBuffer[i] == radarPrevOverlayBuffer[i])
+		{
 			continue;
+		}
+		radarPixelDirty[i] = 0;
+		PIELIGHT mixedColor = radarTileBuffer[i];
+		if (radarOverlayBuffer[i] != 0)
+		{
+			mixedColor = mix(PLfromUDWORD(radarOverlayBuffer[i]), mixedColor);
+		}
 		size_t pixelStartPos = (i * 4);
-		PIELIGHT baseColor = pal_RGBA(pRaderBuffer[pixelStartPos], pRaderBuffer[pixelStartPos + 1], pRaderBuffer[pixelStartPos + 2], pRaderBuffer[pixelStartPos + 3]);
-		PIELIGHT overColor = PLfromUDWORD(radarOverlayBuffer[i]);
-		PIELIGHT mixedColor = mix(overColor, baseColor);
 		pRaderBuffer[pixelStartPos] = mixedColor.byte.r;
 		pRaderBuffer[pixelStartPos + 1] = mixedColor.byte.g;
 		pRaderBuffer[pixelStartPos + 2] = mixedColor.byte.b;
 		pRaderBuffer[pixelStartPos + 3] = mixedColor.byte.a;
+
+		size_t x = i % radarTexWidth;
+		size_t y = i / radarTexWidth;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+	}
+	if (minX > maxX || minY > maxY)
+	{
+		return WzRect(); // nothing changed
 	}
+	return WzRect(static_cast<int>(minX), static_cast<int>(minY), static_cast<int>(maxX - minX + 1), static_cast<int>(maxY - minY + 1));
 }
 
 /** Rotate an array of 2d vectors about a given angle, also translates them after rotating. */
@@ -823,6 +924,7 @@ void radarColour(UDWORD tileNumber, uint8_t r, uint8_t g, uint8_t b)
 	tileColours[tileNumber].byte.g = g;
 	tileColours[tileNumber].byte.b = b;
 	tileColours[tileNumber].byte.a = 255;
+	radarMarkAllTilesDirty();
 }
 
 
@@ -62,6 +62,8 @@ extern bool rotateRadar;
 extern bool radarRotationArrow;
 
 void radarInitVars();			///< Recalculate minimap variables. For initialization code only.
+void radarMarkTileDirty(int x, int y);	///< Tile height, texture or lighting changed, so its minimap colour must be recalculated.
+void radarMarkAllTilesDirty();		///< Recalculate the minimap colour of every tile on the next refresh.
 
 std::shared_ptr<WIDGET> getRadarWidget();
 bool isMouseOverRadar();
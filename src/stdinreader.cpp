@@ -28,6 +28,7 @@
 #include "clparse.h"
 #include "main.h"
 #include "multivote.h"
+#include "perfmetrics.h"
 
 #include <string>
 #include <atomic>
@@ -1038,6 +1039,32 @@ int cmdInputThreadFunc(void *)
 				wz_command_interface_output_room_status_json();
 			});
 		}
+		else if(!strncmpl(line, "metrics interval "))
+		{
+			unsigned intervalSeconds = 0;
+			int r = sscanf(line, "metrics interval %u", &intervalSeconds);
+			if (r != 1)
+			{
+				wz_command_interface_output_onmainthread("WZCMD error: Failed to get metrics interval value!\n");
+			}
+			else if (intervalSeconds > std::numeric_limits<uint32_t>::max() / 1000)
+			{
+				wz_command_interface_output_onmainthread("WZCMD error: metrics interval value is too large!\n");
+			}
+			else
+			{
+				wzAsyncExecOnMainThread([intervalSeconds] {
+					perfmetrics::setPeriodicOutputInterval(intervalSeconds);
+					wz_command_interface_output("WZCMD info: metrics interval set to %u seconds\n", intervalSeconds);
+				});
+			}
+		}
+		else if(!strncmpl(line, "metrics"))
+		{
+			wzAsyncExecOnMainThread([] {
+				wz_command_interface_output_str(perfmetrics::snapshotJSON().c_str());
+			});
+		}
 		else if(!strncmpl(line, "set host ready "))
 		{
 			unsigned hostReadyVal = 0;
@@ -4520,6 +4520,78 @@ bool validLocation(BASE_STATS *psStats, Vector2i pos, uint16_t direction, unsign
 	return true;
 }
 
+StructureBlockedTiles::StructureBlockedTiles(const STRUCTURE_STATS *psStats, unsigned player, int x0, int y0, int width, int height)
+	: x0(x0), y0(y0), width(std::max(width, 0)), height(std::max(height, 0))
+	, sums((this->width + 1) * (this->height + 1), 0)
+{
+	ASSERT_OR_RETURN(, psStats != nullptr && player < MAX_PLAYERS, "Bad parameters");
+
+	// Only mark what validLocation() rejects regardless of the rest of the footprint
+	bool checkTerrain = false;
+	bool checkIncline = false;
+	bool wallsAllowed = false;
+	switch (psStats->type)
+	{
+	case REF_DEMOLISH:
+	case REF_FACTORY_MODULE:
+	case REF_RESEARCH_MODULE:
+	case REF_POWER_MODULE:
+	case REF_RESOURCE_EXTRACTOR:
+	case REF_BRIDGE:
+	case NUM_DIFF_BUILDINGS:
+		break;
+	default:
+		checkTerrain = true;
+		wallsAllowed = psStats->type == REF_DEFENSE || psStats->type == REF_GATE || psStats->type == REF_WALL;
+		checkIncline = !(wallsAllowed || psStats->type == REF_REPAIR_FACILITY);
+		break;
+	}
+	const DebugInputManager& dbgInputManager = gInputManager.debugManager();
+	const bool checkVisible = !bMultiPlayer && !dbgInputManager.debugMappingsAllowed();
+
+	for (int j = 0; j < this->height; ++j)
+	{
+		uint32_t rowSum = 0;
+		for (int i = 0; i < this->width; ++i)
+		{
+			const int x = x0 + i, y = y0 + j;
+			bool blocked = x < scrollMinX + TOO_NEAR_EDGE || x >= scrollMaxX - TOO_NEAR_EDGE ||
+			               y < scrollMinY + TOO_NEAR_EDGE || y >= scrollMaxY - TOO_NEAR_EDGE || !tileOnMap(x, y);
+			if (!blocked)
+			{
+				MAPTILE const *psTile = mapTile(x, y);
+				blocked = checkVisible && !TEST_TILE_VISIBLE(player, psTile);
+				if (!blocked && checkTerrain)
+				{
+					blocked = terrainType(psTile) == TER_WATER || terrainType(psTile) == TER_CLIFFFACE
+					          || withinLandingZone(x, y)
+					          || (TileIsKnownOccupied(psTile, player) && !(wallsAllowed && TileHasWall(psTile)));
+					if (!blocked && checkIncline)
+					{
+						int max, min;
+						getTileMaxMin(x, y, &max, &min);
+						blocked = max - min > MAX_INCLINE;
+					}
+				}
+			}
+			rowSum += blocked ? 1 : 0;
+			sums[(j + 1) * (this->width + 1) + i + 1] = sums[j * (this->width + 1) + i + 1] + rowSum;
+		}
+	}
+}
+
+bool StructureBlockedTiles::anyBlocked(StructureBounds const &b) const
+{
+	const int left = b.map.x - x0, top = b.map.y - y0;
+	const int right = left + b.size.x, bottom = top + b.size.y;
+	if (left < 0 || top < 0 || right > width || bottom > height || b.size.x <= 0 || b.size.y <= 0)
+	{
+		return false;  // Not covered, so not known to be blocked.
+	}
+	const int stride = width + 1;
+	return sums[bottom * stride + right] + sums[top * stride + left] != sums[top * stride + right] + sums[bottom * stride + left];
+}
+
 
 //remove a structure from the map
 static void removeStructFromMap(STRUCTURE *psStruct)
@@ -33,6 +33,7 @@
 #include "baseobject.h"
 
 #include <nonstd/optional.hpp>
+#include <vector>
 
 // how long to wait between CALL_STRUCT_ATTACKED's - plus how long to flash on radar for
 #define ATTACK_CB_PAUSE		5000
@@ -133,6 +134,23 @@ bool isBlueprintTooClose(STRUCTURE_STATS const *stats1, Vector2i pos1, uint16_t
 /// pos in world coords
 bool validLocation(BASE_STATS *psStats, Vector2i pos, uint16_t direction, unsigned player, bool bCheckBuildQueue);
 
+/// Tiles that make validLocation() reject any footprint of a structure type covering them (too near the map
+/// edge, not visible, water, cliffs, steep ground, landing zones, known occupied tiles), as a summed-area
+/// table over an area of the map. Lets callers trying many candidate positions skip hopeless ones in O(1).
+class StructureBlockedTiles
+{
+public:
+	/// x0, y0, width and height give the area of the map to cover, in map coords
+	StructureBlockedTiles(const STRUCTURE_STATS *psStats, unsigned player, int x0, int y0, int width, int height);
+
+	/// Whether validLocation() is certain to reject a structure with these bounds
+	bool anyBlocked(StructureBounds const &b) const;
+
+private:
+	int x0, y0, width, height;
+	std::vector<uint32_t> sums; ///< (width + 1) * (height + 1) prefix sums of blocked tiles
+};
+
 bool isWall(STRUCTURE_TYPE type);                                    ///< Structure is a wall. Not completely sure it handles all cases.
 bool isBuildableOnWalls(STRUCTURE_TYPE type);                        ///< Structure can be built on walls. Not completely sure it handles all cases.
 
@@ -61,6 +61,7 @@
 #include "loop.h"
 #include "wzcrashhandlingproviders.h"
 #include "lighting.h"
+#include "radar.h"
 
 #include "profiling.h"
 
@@ -155,6 +156,8 @@ static int sectorSize = 15;
 static int terrainDistance;
 /// How many sectors have we actually got?
 static int xSectors, ySectors;
+/// World coordinates of the centre of each sector, indexed like sectors (used for distance culling)
+static std::vector<std::pair<int64_t, int64_t>> sectorCentres;
 
 /// Did we initialise the terrain renderer yet?
 static bool terrainInitialised = false;
@@ -665,50 +668,63 @@ static void setSectorDecalVertex_SinglePass(int x, int y, gfx_api::TerrainDecalV
 /**
  * Update the sector for when the terrain is changed.
  */
-static void updateSectorGeometry(int x, int y)
+/// Staging buffers for updateSectorGeometry(), kept around to avoid allocating on every terrain change
+static std::vector<TerrainVertex> geometryUpdateBuffer;
+static std::vector<WaterVertex> waterUpdateBuffer;
+static std::vector<DecalVertex> decalUpdateBuffer;
+
+/**
+ * Regenerate the geometry of the sectors [first, last) (indices into sectors).
+ * Sectors are laid out in the VBOs in index order, so each VBO gets a single update for the whole range.
+ */
+static void updateSectorGeometry(int first, int last)
 {
-	TerrainVertex *geometry;
-	WaterVertex *water;
-	DecalVertex *decaldata;
+	const Sector &firstSector = sectors[first];
+	const Sector &lastSector = sectors[last - 1];
+	const int geometryTotal = lastSector.geometryOffset + lastSector.geometrySize - firstSector.geometryOffset;
+	const int waterTotal = lastSector.waterOffset + lastSector.waterSize - firstSector.waterOffset;
+
+	geometryUpdateBuffer.resize(std::max(geometryTotal, 1)); // reuse a buffer to avoid repeated allocations if possible
+	waterUpdateBuffer.resize(std::max(waterTotal, 1));
 	int geometrySize = 0;
 	int waterSize = 0;
-	int decalSize = 0;
-
-	geometry = new TerrainVertex[sectors[x * ySectors + y].geometrySize];
-	water = (WaterVertex *)malloc(sizeof(WaterVertex) * sectors[x * ySectors + y].waterSize);
-
-	setSectorGeometry(x, y, geometry, water, &geometrySize, &waterSize);
-	ASSERT(geometrySize == sectors[x * ySectors + y].geometrySize, "something went seriously wrong updating the terrain");
-	ASSERT(waterSize    == sectors[x * ySectors + y].waterSize   , "something went seriously wrong updating the terrain");
+	for (int i = first; i < last; ++i)
+	{
+		setSectorGeometry(i / ySectors, i % ySectors, geometryUpdateBuffer.data(), waterUpdateBuffer.data(), &geometrySize, &waterSize);
+	}
+	ASSERT(geometrySize == geometryTotal, "something went seriously wrong updating the terrain");
+	ASSERT(waterSize    == waterTotal   , "something went seriously wrong updating the terrain");
 
-	geometryVBO->update(sizeof(TerrainVertex)*sectors[x * ySectors + y].geometryOffset,
-							sizeof(TerrainVertex)*sectors[x * ySectors + y].geometrySize, geometry,
+	geometryVBO->update(sizeof(TerrainVertex)*firstSector.geometryOffset,
+							sizeof(TerrainVertex)*geometryTotal, geometryUpdateBuffer.data(),
 							gfx_api::buffer::update_flag::non_overlapping_updates_promise);
-	waterVBO->update(sizeof(WaterVertex)*sectors[x * ySectors + y].waterOffset,
-					 sizeof(WaterVertex)*sectors[x * ySectors + y].waterSize, water,
+	waterVBO->update(sizeof(WaterVertex)*firstSector.waterOffset,
+					 sizeof(WaterVertex)*waterTotal, waterUpdateBuffer.data(),
 					 gfx_api::buffer::update_flag::non_overlapping_updates_promise);
 
-	delete[] geometry;
-	free(water);
-
 	if (terrainShaderType == TerrainShaderType::FALLBACK)
 	{
-		if (sectors[x * ySectors + y].decalSize <= 0)
+		const int decalTotal = lastSector.decalOffset + lastSector.decalSize - firstSector.decalOffset;
+		if (decalTotal <= 0)
 		{
 			// Nothing to do here, and glBufferSubData(GL_ARRAY_BUFFER, 0, 0, *) crashes in my graphics driver. Probably shouldn't crash...
 			return;
 		}
 
-		decaldata = (DecalVertex *)malloc(sizeof(DecalVertex) * sectors[x * ySectors + y].decalSize);
-		setSectorDecals(x, y, decaldata, &decalSize);
-		ASSERT(decalSize == sectors[x * ySectors + y].decalSize   , "the amount of decals has changed");
+		decalUpdateBuffer.resize(decalTotal);
+		int decalSize = 0;
+		for (int i = first; i < last; ++i)
+		{
+			setSectorDecals(i / ySectors, i % ySectors, decalUpdateBuffer.data(), &decalSize);
+		}
+		ASSERT(decalSize == decalTotal, "the amount of decals has changed");
 
 		if (decalSize > 0)
 		{
 			if (decalVBO)
 			{
-				decalVBO->update(sizeof(DecalVertex)*sectors[x * ySectors + y].decalOffset,
-								 sizeof(DecalVertex)*sectors[x * ySectors + y].decalSize, decaldata,
+				decalVBO->update(sizeof(DecalVertex)*firstSector.decalOffset,
+								 sizeof(DecalVertex)*decalTotal, decalUpdateBuffer.data(),
 								 gfx_api::buffer::update_flag::non_overlapping_updates_promise);
 			}
 			else
@@ -718,17 +734,19 @@ static void updateSectorGeometry(int x, int y)
 				ASSERT(false, "Didn't have decals, but now we do. Unsupported.");
 			}
 		}
-
-		free(decaldata);
 	}
 	else
 	{
-		terrainDecalVertexUpdateBuffer.resize(sectors[x * ySectors + y].terrainAndDecalSize); // reuse a buffer to avoid repeated allocations if possible
+		const int terrainDecalTotal = lastSector.terrainAndDecalOffset + lastSector.terrainAndDecalSize - firstSector.terrainAndDecalOffset;
+		terrainDecalVertexUpdateBuffer.resize(terrainDecalTotal); // reuse a buffer to avoid repeated allocations if possible
 		int terrainDecalSize = 0;
-		setSectorDecalVertex_SinglePass(x, y, terrainDecalVertexUpdateBuffer.data(), &terrainDecalSize);
-		ASSERT(terrainDecalSize == sectors[x * ySectors + y].terrainAndDecalSize, "Sizes don't match!");
-		terrainDecalVBO->update(sizeof(gfx_api::TerrainDecalVertex)*sectors[x * ySectors + y].terrainAndDecalOffset,
-							 sizeof(gfx_api::TerrainDecalVertex)*sectors[x * ySectors + y].terrainAndDecalSize, terrainDecalVertexUpdateBuffer.data(),
+		for (int i = first; i < last; ++i)
+		{
+			setSectorDecalVertex_SinglePass(i / ySectors, i % ySectors, terrainDecalVertexUpdateBuffer.data(), &terrainDecalSize);
+		}
+		ASSERT(terrainDecalSize == terrainDecalTotal, "Sizes don't match!");
+		terrainDecalVBO->update(sizeof(gfx_api::TerrainDecalVertex)*firstSector.terrainAndDecalOffset,
+							 sizeof(gfx_api::TerrainDecalVertex)*terrainDecalTotal, terrainDecalVertexUpdateBuffer.data(),
 							 gfx_api::buffer::update_flag::non_overlapping_updates_promise);
 	}
 }
@@ -741,6 +759,8 @@ void markTileDirty(int i, int j)
 {
 	int x, y;
 
+	radarMarkTileDirty(i, j);
+
 	if (!terrainInitialised)
 	{
 		return; // will be updated anyway
@@ -1191,6 +1211,14 @@ bool initTerrain()
 	xSectors = (mapWidth + sectorSize - 1) / sectorSize;
 	ySectors = (mapHeight + sectorSize - 1) / sectorSize;
 	sectors = std::unique_ptr<Sector[]> (new Sector[xSectors * ySectors]());
+	sectorCentres.resize(xSectors * ySectors);
+	for (x = 0; x < xSectors; x++)
+	{
+		for (y = 0; y < ySectors; y++)
+		{
+			sectorCentres[x * ySectors + y] = std::make_pair(world_coord(x * sectorSize + sectorSize / 2), world_coord(y * sectorSize + sectorSize / 2));
+		}
+	}
 
 	////////////////////
 	// fill the geometry part of the sectors
@@ -1579,6 +1607,7 @@ void shutdownTerrain()
 		}
 	}
 	sectors = nullptr;
+	sectorCentres.clear();
 	delete lightmap_texture;
 	lightmap_texture = nullptr;
 	lightmapPixmap = nullptr;
@@ -1681,29 +1710,39 @@ static void updateLightMap(const LightMap& lightmap)
 
 static void cullTerrain()
 {
+	const int64_t maxDistance = world_coord(terrainDistance);
+	const int64_t maxDistanceSquared = maxDistance * maxDistance;
+	int dirtyRunStart = -1; // first sector of the current run of consecutive sectors that need updating
+
 	for (int x = 0; x < xSectors; x++)
 	{
+		const int64_t dx = playerPos.p.x - sectorCentres[x * ySectors].first;
+		const int64_t dxSquared = dx * dx;
 		for (int y = 0; y < ySectors; y++)
 		{
-			float xPos = world_coord(x * sectorSize + sectorSize / 2);
-			float yPos = world_coord(y * sectorSize + sectorSize / 2);
-			float distance = pow(playerPos.p.x - xPos, 2) + pow(playerPos.p.z - yPos, 2);
+			const int i = x * ySectors + y;
+			const int64_t dy = playerPos.p.z - sectorCentres[i].second;
 
-			if (distance > pow((double)world_coord(terrainDistance), 2))
-			{
-				sectors[x * ySectors + y].draw = false;
-			}
-			else
+			sectors[i].draw = dxSquared + dy * dy <= maxDistanceSquared;
+			if (sectors[i].draw && sectors[i].dirty)
 			{
-				sectors[x * ySectors + y].draw = true;
-				if (sectors[x * ySectors + y].dirty)
+				sectors[i].dirty = false;
+				if (dirtyRunStart < 0)
 				{
-					updateSectorGeometry(x, y);
-					sectors[x * ySectors + y].dirty = false;
+					dirtyRunStart = i;
 				}
 			}
+			else if (dirtyRunStart >= 0)
+			{
+				updateSectorGeometry(dirtyRunStart, i);
+				dirtyRunStart = -1;
+			}
 		}
 	}
+	if (dirtyRunStart >= 0)
+	{
+		updateSectorGeometry(dirtyRunStart, xSectors * ySectors);
+	}
 }
 
 static void drawDepthOnly(const glm::mat4 &ModelViewProjection, const glm::vec4 &paramsXLight, const glm::vec4 &paramsYLight, bool withOffset)
@@ -1515,15 +1515,9 @@ static bool structDoubleCheck(BASE_STATS *psStat, UDWORD xx, UDWORD yy, SDWORD m
 	// check against building in a gateway, as this can seriously block AI passages
 	for (auto psGate : gwGetGateways())
 	{
-		for (x = xx; x <= xBR; x++)
+		if (xx <= psGate->x2 && xBR >= psGate->x1 && yy <= psGate->y2 && yBR >= psGate->y1)
 		{
-			for (y = yy; y <= yBR; y++)
-			{
-				if (x >= psGate->x1 && x <= psGate->x2 && y >= psGate->y1 && y <= psGate->y2)
-				{
-					return false;
-				}
-			}
+			return false;
 		}
 	}
 
@@ -1605,8 +1599,12 @@ optional<scr_position> wzapi::pickStructLocation(WZAPI_PARAMS(const DROID *psDro
 
 	PROPULSION_TYPE propType = (psDroid) ? psDroid->getPropulsionStats()->propulsionType : PROPULSION_TYPE_WHEELED;
 
+	// tiles that rule out any position whose footprint covers them, built once the original location failed
+	std::unique_ptr<StructureBlockedTiles> blockedTiles;
+
 	// save a lot of typing... checks whether a position is valid
 #define LOC_OK(_x, _y) (tileOnMap(_x, _y) && \
+                        (!blockedTiles || !blockedTiles->anyBlocked(getStructureBounds(psStat, world_coord(Vector2i(_x, _y)) + offset, 0))) && \
                         (!psDroid || fpathCheck(psDroid->pos, Vector3i(world_coord(_x), world_coord(_y), 0), propType)) \
                         && validLocation(psStat, world_coord(Vector2i(_x, _y)) + offset, 0, player, false) && structDoubleCheck(psStat, _x, _y, maxBlockingTiles, propType))
 
@@ -1615,6 +1613,11 @@ optional<scr_position> wzapi::pickStructLocation(WZAPI_PARAMS(const DROID *psDro
 	{
 		found = true;
 	}
+	else
+	{
+		blockedTiles = std::make_unique<StructureBlockedTiles>(psStat, player, startX - numIterations, startY - numIterations,
+		                                                       2 * numIterations + psStat->baseWidth + 1, 2 * numIterations + psStat->baseBreadth + 1);
+	}
 
 	// try some locations nearby
 	for (incX = 1, incY = 1; incX < numIterations && !found; incX++, incY++)
@@ -3428,6 +3431,7 @@ bool wzapi::transformPlayerToSpectator(WZAPI_PARAMS(int player))
 // flag all droids as requiring update on next frame
 static void dirtyAllDroids(int player)
 {
+	droidUpgradesChanged(player);
 	for (DROID *psDroid : apsDroidLists[player])
 	{
 		psDroid->flags.set(OBJECT_FLAG_DIRTY);
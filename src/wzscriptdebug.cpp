@@ -251,6 +251,28 @@ static RowDataModel fillTriggersModel(const std::vector<scripting_engine::timerN
 	return result;
 }
 
+static nlohmann::ordered_json fillPerformanceModel(const std::vector<scripting_engine::instancePerformanceSnapshot>& performance_snapshot)
+{
+	nlohmann::ordered_json result = nlohmann::ordered_json::object();
+	for (const auto &load : performance_snapshot)
+	{
+		if (load.instance == nullptr)
+		{
+			continue;
+		}
+		nlohmann::ordered_json info = nlohmann::ordered_json::object();
+		info["calls"] = load.calls;
+		info["total (usec)"] = load.time;
+		info["avg (usec)"] = (load.calls > 0) ? (load.time / load.calls) : 0;
+		info["last tick (usec)"] = load.lastTickTime;
+		info["worst tick (usec)"] = load.worstTickTime;
+		info["worst tick at"] = load.worstTickGameTime;
+		info["ticks over budget"] = load.ticksOverBudget;
+		result[load.instance->scriptName() + ":" + std::to_string(load.instance->player())] = std::move(info);
+	}
+	return result;
+}
+
 static nlohmann::ordered_json fillMainModel()
 {
 	const std::vector<std::string> lev_type = {
@@ -2611,6 +2633,9 @@ void WZScriptDebugger::switchPanel(WZScriptDebugger::ScriptDebuggerPanel newPane
 		case ScriptDebuggerPanel::Triggers:
 			psPanel = createTriggersPanel();
 			break;
+		case ScriptDebuggerPanel::Performance:
+			psPanel = createPerformancePanel();
+			break;
 		case ScriptDebuggerPanel::Messages:
 			psPanel = createMessagesPanel();
 			break;
@@ -2717,6 +2742,20 @@ std::shared_ptr<WIDGET> WZScriptDebugger::createTriggersPanel()
 	return panel;
 }
 
+std::shared_ptr<WIDGET> WZScriptDebugger::createPerformancePanel()
+{
+	auto result = JSONTableWidget::make("Script Performance:");
+	result->updateData(fillPerformanceModel(debugInterface->debug_GetPerformanceSnapshot()));
+	std::weak_ptr<scripting_engine::DebugInterface> weakDebugInterface = debugInterface;
+	result->setUpdateButtonFunc([weakDebugInterface](JSONTableWidget& tableWidget){
+		if (auto strongDebugInterface = weakDebugInterface.lock())
+		{
+			tableWidget.updateData(fillPerformanceModel(strongDebugInterface->debug_GetPerformanceSnapshot()), true);
+		}
+	}, GAME_TICKS_PER_SEC);
+	return result;
+}
+
 std::shared_ptr<WIDGET> WZScriptDebugger::createMessagesPanel()
 {
 	auto panel = WzScriptMessagesPanel::make();
@@ -2791,6 +2830,7 @@ std::shared_ptr<WZScriptDebugger> WZScriptDebugger::make(const std::shared_ptr<s
 	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Contexts, "Contexts");
 	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Players, "Players");
 	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Triggers, "Triggers");
+	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Performance, "Performance");
 	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Messages, "Messages");
 	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Labels, "Labels");
 	addTextTabButton(result->pageTabs, ScriptDebuggerPanel::Graphics, "Graphics");
@@ -80,6 +80,7 @@ private:
 	std::shared_ptr<WIDGET> createContextsPanel();
 	std::shared_ptr<WIDGET> createPlayersPanel();
 	std::shared_ptr<WIDGET> createTriggersPanel();
+	std::shared_ptr<WIDGET> createPerformancePanel();
 	std::shared_ptr<WIDGET> createMessagesPanel();
 	std::shared_ptr<WIDGET> createLabelsPanel();
 	std::shared_ptr<W_FORM> createGraphicsPanel();
@@ -91,6 +92,7 @@ private:
 		Contexts,
 		Players,
 		Triggers,
+		Performance,
 		Messages,
 		Labels,
 		Graphics